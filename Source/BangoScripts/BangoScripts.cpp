@@ -5,14 +5,39 @@
 #include "CanvasItem.h"
 #include "Modules/ModuleManager.h"
 
+#if WITH_EDITOR
+#include "BangoScripts/Core/BangoActorIDTable.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "UObject/ObjectSaveContext.h"
+#endif
+
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
 void FBangoScriptsModule::StartupModule()
 {
+#if WITH_EDITOR
+	// Bake actor ID tables into levels as they are cooked. World Partition cell levels are generated during cook and are caught here too.
+	PreSaveHandle = FCoreUObjectDelegates::OnObjectPreSave.AddLambda([] (UObject* Object, FObjectPreSaveContext SaveContext)
+	{
+		if (!SaveContext.IsCooking())
+		{
+			return;
+		}
+		
+		if (ULevel* Level = Cast<ULevel>(Object))
+		{
+			UBangoActorIDTable::BakeLevel(Level);
+		}
+	});
+#endif
 }
 
 void FBangoScriptsModule::ShutdownModule()
 {
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPreSave.Remove(PreSaveHandle);
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -11,4 +11,9 @@ public:
 	/** IModuleInterface implementation */
 	void StartupModule() override;
 	void ShutdownModule() override;
+	
+#if WITH_EDITOR
+private:
+	FDelegateHandle PreSaveHandle;
+#endif
 };
@@ -2,9 +2,12 @@
 
 #include "CanvasItem.h"
 #include "TimerManager.h"
+#include "BangoScripts/Core/BangoActorIDTable.h"
 #include "BangoScripts/Subsystem/BangoActorIDSubsystem.h"
+#include "BangoScripts/Subsystem/BangoComponentIndexSubsystem.h"
 #include "BangoScripts/Utility/BangoScriptsLog.h"
 #include "Engine/Canvas.h"
+#include "Engine/Level.h"
 #include "Engine/Texture.h"
 #include "Engine/Texture2D.h"
 #include "Fonts/FontMeasure.h"
@@ -44,6 +47,31 @@ void UBangoActorIDComponent::PostDuplicate(bool bDuplicateForPIE)
 #endif
 }
 
+bool UBangoActorIDComponent::NeedsLoadForClient() const
+{
+	return !IsBakedIntoLevelTable() && Super::NeedsLoadForClient();
+}
+
+bool UBangoActorIDComponent::NeedsLoadForServer() const
+{
+	return !IsBakedIntoLevelTable() && Super::NeedsLoadForServer();
+}
+
+bool UBangoActorIDComponent::IsBakedIntoLevelTable() const
+{
+#if WITH_EDITOR
+	// Strip only if the level's table was baked with us in it; runtime spawned actors and templates still need the component to register themselves
+	if (IsRunningCookCommandlet() && !IsTemplate())
+	{
+		UBangoActorIDTable* Table = UBangoActorIDTable::Get(GetComponentLevel());
+		
+		return Table && Table->Contains(BangoGuid);
+	}
+#endif
+	
+	return false;
+}
+
 void UBangoActorIDComponent::BeginPlay()
 {
 	Super::BeginPlay();
@@ -86,11 +114,12 @@ void UBangoActorIDComponent::SetBangoName(FName NewID)
 }
 #endif
 
-#if WITH_EDITOR
 void UBangoActorIDComponent::OnRegister()
 {
 	Super::OnRegister();
 	
+	UBangoComponentIndexSubsystem::RegisterComponent(this);
+	
 #if WITH_EDITOR
 	if (Bango::Editor::IsComponentInEditedLevel(this))
 	{
@@ -112,16 +141,15 @@ void UBangoActorIDComponent::OnRegister()
 #endif
 	
 }
-#endif
 
-#if WITH_EDITOR
 void UBangoActorIDComponent::OnUnregister()
 {
 	//BangoDebugDraw_Unregister(this);
 	
+	UBangoComponentIndexSubsystem::UnregisterComponent(this);
+	
 	Super::OnUnregister();
 }
-#endif
 
 #if WITH_EDITOR
 void UBangoActorIDComponent::EnsureValidGuid()
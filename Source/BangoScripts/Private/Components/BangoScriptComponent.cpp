@@ -1,10 +1,16 @@
 ﻿#include "BangoScripts/Components/BangoScriptComponent.h"
 
 #include "TextureResource.h"
+#include "BangoScripts/Actors/BangoInitScriptActor.h"
 #include "BangoScripts/Core/BangoScript.h"
+#include "BangoScripts/Subsystem/BangoComponentIndexSubsystem.h"
 #include "BangoScripts/Subsystem/BangoScriptSubsystem.h"
 #include "BangoScripts/Utility/BangoScriptsLog.h"
 #include "Components/BillboardComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
 #include "UObject/ICookInfo.h"
 #include "Engine/Texture2D.h"
 #include "Framework/Application/SlateApplication.h"
@@ -55,7 +61,8 @@ void UBangoScriptComponent::BeginPlay()
 {
 	Super::BeginPlay();
 	
-	if (bRunOnBeginPlay)
+	// Init script actors launch their scripts through the script subsystem, in level init order
+	if (bRunOnBeginPlay && !GetOwner()->IsA<ABangoInitScriptActor>())
 	{	
 		Run();
 	}
@@ -63,11 +70,22 @@ void UBangoScriptComponent::BeginPlay()
 
 // ----------------------------------------------
 
-#if WITH_EDITOR
+void UBangoScriptComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseStreamingHints();
+	
+	Super::EndPlay(EndPlayReason);
+}
+
+// ----------------------------------------------
+
 void UBangoScriptComponent::OnRegister()
 {
 	Super::OnRegister();
 	
+	UBangoComponentIndexSubsystem::RegisterComponent(this);
+	
+#if WITH_EDITOR
 	Bango::Debug::PrintComponentState(this, "OnRegister");
 	
 	if (Bango::Editor::IsComponentInEditedLevel(this))
@@ -146,14 +164,16 @@ void UBangoScriptComponent::OnRegister()
 	UpdateBillboard();
 	
 	// Bango::Debug::PrintComponentState(this, "OnRegister_Late");
-}
 #endif
+}
 
 // ----------------------------------------------
 
-#if WITH_EDITOR
 void UBangoScriptComponent::OnUnregister()
 {
+	UBangoComponentIndexSubsystem::UnregisterComponent(this);
+	
+#if WITH_EDITOR
 	Bango::Debug::PrintComponentState(this, "OnUnregister");
 	
 	if (bDebugRegistered)
@@ -167,12 +187,12 @@ void UBangoScriptComponent::OnUnregister()
 	{
 		FBangoEditorDelegates::OnScriptContainerDestroyed.Broadcast(AsScriptHolder(), EBangoScriptDeletedHelper::OwnerDestroyed);
 	}
+#endif
 	
 	Super::OnUnregister();
 	
 	// Bango::Debug::PrintComponentState(this, "OnUnregister_Late");	
 }
-#endif
 
 // ----------------------------------------------
 
@@ -369,6 +389,8 @@ void UBangoScriptComponent::PreSave(FObjectPreSaveContext SaveContext)
 	
 	Super::PreSave(SaveContext);
 	
+	ScriptContainer.RefreshStreamingHintLocations();
+	
 	// TODO: SAVE NUISANCES - not sure if I need this code or not to reduce save-all nuisances
 	/*
 	// The level scripts subsystem may be fixing this up after another tick. So let's save the referenced script after another tick, too.
@@ -424,6 +446,25 @@ void UBangoScriptComponent::Run()
 		return;
 	}
 	
+	if (StreamingHintTimer.IsValid())
+	{
+		// Already waiting on streaming
+		return;
+	}
+	
+	if (!ScriptContainer.AreStreamingHintsLoaded() && GetWorld()->GetWorldPartition())
+	{
+		RequestStreamingHints();
+		return;
+	}
+	
+	EnqueueScript();
+}
+
+// ----------------------------------------------
+
+void UBangoScriptComponent::EnqueueScript()
+{
 	RunningHandle = UBangoScriptSubsystem::EnqueueScript(ScriptContainer.GetScriptClass(), GetOwner(), ScriptContainer.GetPropertyBag());
 	
 	if (RunningHandle.IsRunning())
@@ -562,6 +603,104 @@ void UBangoScriptComponent::OnScriptFinished(FBangoScriptHandle FinishedHandle)
 	}
 	
 	RunningHandle.Expire();
+	
+	// Targets only needed to stay loaded while the script was running
+	ReleaseStreamingHints();
+}
+
+// ----------------------------------------------
+
+void UBangoScriptComponent::RequestStreamingHints()
+{
+	UWorld* World = GetWorld();
+	
+	UWorldPartitionSubsystem* WorldPartitionSubsystem = World->GetSubsystem<UWorldPartitionSubsystem>();
+	
+	if (!WorldPartitionSubsystem)
+	{
+		EnqueueScript();
+		return;
+	}
+	
+	if (!bStreamingHintsRegistered)
+	{
+		WorldPartitionSubsystem->RegisterStreamingSourceProvider(this);
+		bStreamingHintsRegistered = true;
+	}
+	
+	StreamingHintRequestTime = World->GetTimeSeconds();
+	
+	auto PollDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::PollStreamingHints);
+	World->GetTimerManager().SetTimer(StreamingHintTimer, PollDelegate, 0.1f, true);
+}
+
+// ----------------------------------------------
+
+void UBangoScriptComponent::PollStreamingHints()
+{
+	UWorld* World = GetWorld();
+	
+	bool bLoaded = ScriptContainer.AreStreamingHintsLoaded();
+	
+	if (!bLoaded && World->GetTimeSeconds() - StreamingHintRequestTime < StreamingHintTimeout)
+	{
+		return;
+	}
+	
+	if (!bLoaded)
+	{
+		UE_LOG(LogBango, Warning, TEXT("Streaming hint actors for %s did not load within %.1fs, running script anyway"), *GetPathName(), StreamingHintTimeout);
+	}
+	
+	World->GetTimerManager().ClearTimer(StreamingHintTimer);
+	
+	EnqueueScript();
+	
+	if (!RunningHandle.IsRunning())
+	{
+		ReleaseStreamingHints();
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoScriptComponent::ReleaseStreamingHints()
+{
+	UWorld* World = GetWorld();
+	
+	if (!World)
+	{
+		return;
+	}
+	
+	World->GetTimerManager().ClearTimer(StreamingHintTimer);
+	
+	if (bStreamingHintsRegistered)
+	{
+		if (UWorldPartitionSubsystem* WorldPartitionSubsystem = World->GetSubsystem<UWorldPartitionSubsystem>())
+		{
+			WorldPartitionSubsystem->UnregisterStreamingSourceProvider(this);
+		}
+		
+		bStreamingHintsRegistered = false;
+	}
+}
+
+// ----------------------------------------------
+
+bool UBangoScriptComponent::GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const
+{
+	for (const FBangoStreamingHintActorRef& Hint : ScriptContainer.StreamingHintActorRefs)
+	{
+		FWorldPartitionStreamingSource& StreamingSource = OutStreamingSources.AddDefaulted_GetRef();
+		StreamingSource.Name = GetFName();
+		StreamingSource.Location = Hint.Location;
+		StreamingSource.Rotation = FRotator::ZeroRotator;
+		StreamingSource.TargetState = EStreamingSourceTargetState::Activated;
+		StreamingSource.bBlockOnSlowLoading = false;
+	}
+	
+	return !ScriptContainer.StreamingHintActorRefs.IsEmpty();
 }
 
 // ----------------------------------------------
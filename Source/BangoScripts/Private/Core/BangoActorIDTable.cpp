@@ -0,0 +1,93 @@
+﻿#include "BangoScripts/Core/BangoActorIDTable.h"
+
+#include "BangoScripts/Components/BangoActorIDComponent.h"
+#include "BangoScripts/Utility/BangoScriptsLog.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+
+// ----------------------------------------------
+
+UBangoActorIDTable* UBangoActorIDTable::Get(ULevel* Level)
+{
+	if (!Level)
+	{
+		return nullptr;
+	}
+
+	return Cast<UBangoActorIDTable>(Level->GetAssetUserDataOfClass(UBangoActorIDTable::StaticClass()));
+}
+
+// ----------------------------------------------
+
+bool UBangoActorIDTable::Contains(const FGuid& Guid) const
+{
+	return EntryGuids.Contains(Guid);
+}
+
+// ----------------------------------------------
+
+void UBangoActorIDTable::PostLoad()
+{
+	Super::PostLoad();
+
+	BuildEntryGuids();
+}
+
+// ----------------------------------------------
+
+void UBangoActorIDTable::BuildEntryGuids()
+{
+	EntryGuids.Reset();
+	EntryGuids.Reserve(Entries.Num());
+
+	for (const FBangoActorIDTableEntry& Entry : Entries)
+	{
+		EntryGuids.Add(Entry.Guid);
+	}
+}
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+void UBangoActorIDTable::BakeLevel(ULevel* Level)
+{
+	check(Level);
+
+	Level->RemoveUserDataOfClass(UBangoActorIDTable::StaticClass());
+
+	TArray<FBangoActorIDTableEntry> BakedEntries;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		UBangoActorIDComponent* IDComponent = Actor->FindComponentByClass<UBangoActorIDComponent>();
+
+		if (!IDComponent || !IDComponent->GetBangoGuid().IsValid())
+		{
+			continue;
+		}
+
+		FBangoActorIDTableEntry& Entry = BakedEntries.AddDefaulted_GetRef();
+		Entry.Actor = Actor;
+		Entry.Name = IDComponent->GetBangoName();
+		Entry.Guid = IDComponent->GetBangoGuid();
+	}
+
+	if (BakedEntries.IsEmpty())
+	{
+		return;
+	}
+
+	UBangoActorIDTable* Table = NewObject<UBangoActorIDTable>(Level);
+	Table->Entries = MoveTemp(BakedEntries);
+	Table->BuildEntryGuids();
+
+	Level->AddAssetUserData(Table);
+
+	UE_LOG(LogBango, Verbose, TEXT("Baked %i actor IDs into level %s"), Table->Entries.Num(), *Level->GetPathName());
+}
+#endif
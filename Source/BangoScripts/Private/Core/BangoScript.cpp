@@ -4,16 +4,80 @@
 #include "BangoScripts/LatentActions/BangoSleepAction.h"
 #include "BangoScripts/Subsystem/BangoScriptSubsystem.h"
 #include "BangoScripts/Utility/BangoScriptsLog.h"
+#include "Blueprint/BlueprintExceptionInfo.h"
 #include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
 #include "Misc/DataValidation.h"
+#include "StructUtils/PropertyBag.h"
 #include "UObject/AssetRegistryTagsContext.h"
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
+#if WITH_EDITOR
+#include "BangoScripts/Core/BangoScriptBlueprint.h"
+#endif
+
 #if WITH_EDITOR
 DataValidationDelegate UBangoScript::OnScriptRequestValidation;
 #endif
 
+bool FBangoScriptActorRef::Serialize(FArchive& Ar)
+{
+	FSoftObjectPathSerializationScope SerializationScope(ESoftObjectPathCollectType::NeverCollect);
+	Ar << ActorPath;
+	return true;
+}
+
+AActor* UBangoScript::GetActorRef(int32 Index) const
+{
+	if (!ActorRefTable.IsValidIndex(Index))
+	{
+		UE_LOG(LogBango, Warning, TEXT("Script %s has no actor ref at index %i, try recompiling it"), *GetClass()->GetName(), Index);
+		return nullptr;
+	}
+	
+	return Cast<AActor>(ActorRefTable[Index].ActorPath.ResolveObject());
+}
+
+void UBangoScript::SetThis(UObject* Runner)
+{
+	This = Runner;
+	
+	for (FObjectPropertyBase* Property : GetClass()->GetDefaultObject<UBangoScript>()->GetResolvedTypedThisProperties())
+	{
+		Property->SetObjectPropertyValue_InContainer(this, Runner && Runner->IsA(Property->PropertyClass) ? Runner : nullptr);
+	}
+}
+
+const TArray<FObjectPropertyBase*>& UBangoScript::GetResolvedTypedThisProperties()
+{
+	check(HasAnyFlags(RF_ClassDefaultObject));
+	
+	if (bTypedThisPropertiesResolved)
+	{
+		return ResolvedTypedThisProperties;
+	}
+	
+	ResolvedTypedThisProperties.Reset(TypedThisProperties.Num());
+	
+	for (const FName& PropertyName : TypedThisProperties)
+	{
+		FObjectPropertyBase* Property = FindFProperty<FObjectPropertyBase>(GetClass(), PropertyName);
+		
+		if (!Property)
+		{
+			UE_LOG(LogBango, Warning, TEXT("Script %s has no typed This property %s, try recompiling it"), *GetClass()->GetName(), *PropertyName.ToString());
+			continue;
+		}
+		
+		ResolvedTypedThisProperties.Add(Property);
+	}
+	
+	bTypedThisPropertiesResolved = true;
+	
+	return ResolvedTypedThisProperties;
+}
+
 void UBangoScript::Finish(UBangoScript* Script)
 {
     if (UWorld* World = GEngine->GetWorldFromContextObject(Script, EGetWorldErrorMode::LogAndReturnNull))
@@ -30,102 +94,184 @@ void UBangoScript::Finish(UBangoScript* Script)
 	Script->MarkAsGarbage();
 }
 
-int32 UBangoScript::LaunchSleep_Internal(const UObject* WorldContextObject, float Duration, struct FLatentActionInfo LatentInfo, FOnLatentActionTick BPDelayTickEvent, FOnLatentActionCompleted BPDelayCompleteEvent)
+FBangoScriptHandle UBangoScript::RunScript_Internal(TSubclassOf<UBangoScript> ScriptClass, const TArray<FName>& InputNames, FOnRunScriptFinished OnFinished)
 {
-    int32 UUID = LatentInfo.UUID;
+    // Only ever called through execRunScript_Internal
+    checkNoEntry();
+    return FBangoScriptHandle::GetNullHandle();
+}
+
+DEFINE_FUNCTION(UBangoScript::execRunScript_Internal)
+{
+    P_GET_OBJECT(UClass, ScriptClass);
+    P_GET_TARRAY_REF(FName, InputNames);
+    P_GET_PROPERTY(FDelegateProperty, OnFinished);
     
-    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+    TArray<FPropertyBagPropertyDesc, TInlineAllocator<8>> InputDescs;
+    TArray<const void*, TInlineAllocator<8>> InputValues;
+    TArray<FName, TInlineAllocator<2>> UnresolvedInputs;
+    
+    for (const FName& InputName : InputNames)
     {
-        FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
-        if (!LatentActionManager.FindExistingAction<FBangoSleepAction>(LatentInfo.CallbackTarget, UUID))
+        Stack.MostRecentProperty = nullptr;
+        Stack.MostRecentPropertyAddress = nullptr;
+        Stack.StepCompiledIn<FProperty>(nullptr);
+        
+        if (Stack.MostRecentProperty && Stack.MostRecentPropertyAddress)
         {
-            FBangoSleepAction* SleepAction = new FBangoSleepAction(Duration, LatentInfo);
-            LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, UUID, SleepAction);
-
-            FOnLatentActionTick TickDelegate;
-            TickDelegate = BPDelayTickEvent;
-            
-            SleepAction->OnTick.AddLambda([TickDelegate]()
-            {
-                TickDelegate.ExecuteIfBound();
-            });
-
-            FOnLatentActionCompleted CompleteDelegate;
-            CompleteDelegate = BPDelayCompleteEvent;
-            
-            SleepAction->OnComplete.AddLambda([CompleteDelegate]()
-            {
-                CompleteDelegate.ExecuteIfBound();
-            });
-
-            return UUID;
+            InputDescs.Emplace(InputName, Stack.MostRecentProperty);
+            InputValues.Add(Stack.MostRecentPropertyAddress);
+        }
+        else
+        {
+            UnresolvedInputs.Add(InputName);
         }
     }
-
-    UE_LOG(LogBango, Warning, TEXT("Unknown error running LaunchSleep_Internal!"));
-    return 0;
-}
-
-void UBangoScript::CancelSleep_Internal(UObject* WorldContextObject, int32 ActionUUID)
-{
-    if (ActionUUID == 0)
+    
+    P_FINISH;
+    
+    // Same as the engine's wildcard thunks: report it as a script error, the sub-script then runs with that input's default
+    for (const FName& InputName : UnresolvedInputs)
     {
-        UE_LOG(LogBango, Warning, TEXT("CancelSleep_Internal called with ActionUUID {%i}"), ActionUUID);
-        return;
+        const FBlueprintExceptionInfo ExceptionInfo(
+            EBlueprintExceptionType::AccessViolation,
+            FText::Format(LOCTEXT("RunScript_UnresolvedInput", "Failed to resolve script input '{0}' for Run Script, it will use its default value"), FText::FromName(InputName)));
+        
+        FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
     }
     
-    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+    P_NATIVE_BEGIN;
+    
+    FInstancedPropertyBag Inputs;
+    
+    if (!InputDescs.IsEmpty())
     {
-        FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
-        FBangoSleepAction* Action = LatentActionManager.FindExistingAction<FBangoSleepAction>(WorldContextObject, ActionUUID);
-
-        if (Action)
+        Inputs.AddProperties(InputDescs);
+        
+        void* InputsMemory = Inputs.GetMutableValue().GetMemory();
+        
+        for (int32 i = 0; i < InputDescs.Num(); ++i)
         {
-            Action->Cancel();
+            const FPropertyBagPropertyDesc* Desc = Inputs.FindPropertyDescByName(InputDescs[i].Name);
+            
+            if (Desc && Desc->CachedProperty)
+            {
+                Desc->CachedProperty->CopyCompleteValue(Desc->CachedProperty->ContainerPtrToValuePtr<void>(InputsMemory), InputValues[i]);
+            }
         }
     }
+    
+    // Sub-scripts run on behalf of the same object as the script that launched them
+    UObject* Runner = P_THIS->This.IsValid() ? P_THIS->This.Get() : P_THIS;
+    
+    *(FBangoScriptHandle*)RESULT_PARAM = UBangoScriptSubsystem::RunScript(ScriptClass, Runner, MoveTemp(Inputs), FOnRunScriptFinished(OnFinished));
+    
+    P_NATIVE_END;
 }
 
-void UBangoScript::SkipSleep_Internal(UObject* WorldContextObject, int32 ActionUUID)
+void UBangoScript::Sleep_Internal(const UObject* WorldContextObject, float Duration, EBangoSleepInput Input, FOnLatentActionTick TickDelegate, struct FLatentActionInfo LatentInfo)
 {
-    if (ActionUUID == 0)
+    UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+    
+    if (!World)
     {
-        UE_LOG(LogBango, Warning, TEXT("SkipSleep_Internal called with ActionUUID {%i}"), ActionUUID);
         return;
     }
     
-    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+    FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+    FBangoSleepAction* SleepAction = LatentActionManager.FindExistingAction<FBangoSleepAction>(LatentInfo.CallbackTarget, LatentInfo.UUID);
+    
+    switch (Input)
     {
-        FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
-        FBangoSleepAction* Action = LatentActionManager.FindExistingAction<FBangoSleepAction>(WorldContextObject, ActionUUID);
-
-        if (Action)
+        case EBangoSleepInput::Start:
         {
-            Action->Skip();
+            if (SleepAction)
+            {
+                return;
+            }
+            
+            SleepAction = new FBangoSleepAction(Duration, LatentInfo);
+            
+            if (TickDelegate.IsBound())
+            {
+                SleepAction->OnTick.AddLambda([TickDelegate]()
+                {
+                    TickDelegate.ExecuteIfBound();
+                });
+            }
+            
+            LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, SleepAction);
+            break;
         }
-    }    
+        case EBangoSleepInput::Skip:
+        {
+            if (SleepAction)
+            {
+                SleepAction->Skip();
+            }
+            break;
+        }
+        case EBangoSleepInput::Cancel:
+        {
+            if (SleepAction)
+            {
+                SleepAction->Cancel();
+            }
+            break;
+        }
+    }
 }
 
-void UBangoScript::SetSleepPause_Internal(UObject* WorldContextObject, bool bPaused, int32 ActionUUID)
+void UBangoScript::SetSleepConditions_Internal(bool bSkip, bool bCancel, bool bPaused)
 {
-    if (ActionUUID == 0)
+    FBangoSleepAction* SleepAction = FBangoSleepAction::GetPollingAction();
+    
+    if (!SleepAction)
     {
-        UE_LOG(LogBango, Warning, TEXT("SetSleepPause_Internal called with ActionUUID {%i}"), ActionUUID);
+        UE_LOG(LogBango, Warning, TEXT("SetSleepConditions_Internal called outside of a sleep action tick!"));
         return;
     }
     
-    if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
-    {
-        FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
-        FBangoSleepAction* Action = LatentActionManager.FindExistingAction<FBangoSleepAction>(WorldContextObject, ActionUUID);
-
-        if (Action)
-        {
-            Action->SetPaused(bPaused);
-        }
-    }    
+    SleepAction->ApplyConditions(bSkip, bCancel, bPaused);
 }
 
+#if WITH_EDITOR
+void UBangoScript::PostCDOCompiled(const FPostCDOCompiledContext& Context)
+{
+	Super::PostCDOCompiled(Context);
+	
+	// The class's properties were just rebuilt
+	ResolvedTypedThisProperties.Reset();
+	bTypedThisPropertiesResolved = false;
+	
+	if (Context.bIsSkeletonOnly)
+	{
+		return;
+	}
+	
+	UBangoScriptBlueprint* Blueprint = Cast<UBangoScriptBlueprint>(UBlueprint::GetBlueprintFromClass(GetClass()));
+	
+	if (!Blueprint)
+	{
+		return;
+	}
+	
+	// Nothing was expanded while regenerating on load, keep what was serialized
+	if (Context.bIsRegeneratingOnLoad && !Blueprint->HasCompiledActorRefs())
+	{
+		return;
+	}
+	
+	TArray<FSoftObjectPath> CompiledActorRefs = Blueprint->ConsumeCompiledActorRefs();
+	
+	ActorRefTable.Reset(CompiledActorRefs.Num());
+	
+	for (FSoftObjectPath& ActorPath : CompiledActorRefs)
+	{
+		ActorRefTable.AddDefaulted_GetRef().ActorPath = MoveTemp(ActorPath);
+	}
+}
+#endif
 
 #if WITH_EDITOR
 EDataValidationResult UBangoScript::IsDataValid(class FDataValidationContext& Context) const
@@ -2,6 +2,12 @@
 
 #if WITH_EDITOR
 #include "Editor.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Hash/xxhash.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/EngineVersion.h"
 #endif
 #include "BangoScripts/Components/BangoScriptComponent.h"
 #include "Misc/PackageName.h"
@@ -139,6 +145,301 @@ TWeakObjectPtr<UObject> UBangoScriptBlueprint::GetCurrentObjectBeingDebugged() c
 
 // ----------------------------------------------
 
+#if WITH_EDITOR
+int32 UBangoScriptBlueprint::AddCompiledActorRef(const FSoftObjectPath& ActorPath)
+{
+	return CompiledActorRefs.AddUnique(ActorPath);
+}
+#endif
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+TArray<FSoftObjectPath> UBangoScriptBlueprint::ConsumeCompiledActorRefs()
+{
+	return MoveTemp(CompiledActorRefs);
+}
+#endif
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+namespace Bango::GraphHash
+{
+	// Bump this whenever the script compiler itself changes its output, so that every script is treated as changed. Node classes that change how they
+	// expand bump their own BangoExpansionVersion class metadata instead, which only invalidates scripts that use them.
+	constexpr uint32 Version = 2;
+	
+	const FName ExpansionVersionKey = "BangoExpansionVersion";
+	
+	template<typename T>
+	void HashValue(FXxHash64Builder& Builder, const T& Value)
+	{
+		static_assert(TIsPODType<T>::Value);
+		Builder.Update(&Value, sizeof(T));
+	}
+	
+	void HashString(FXxHash64Builder& Builder, FStringView String)
+	{
+		// Length first, so that neighbouring strings can't run into each other
+		HashValue(Builder, String.Len());
+		Builder.Update(String.GetData(), String.Len() * sizeof(TCHAR));
+	}
+	
+	void HashName(FXxHash64Builder& Builder, FName Name)
+	{
+		HashString(Builder, Name.ToString());
+	}
+	
+	void HashObjectPath(FXxHash64Builder& Builder, const UObject* Object)
+	{
+		HashString(Builder, Object ? Object->GetPathName() : FString());
+	}
+	
+	void HashPinType(FXxHash64Builder& Builder, const FEdGraphPinType& PinType)
+	{
+		HashName(Builder, PinType.PinCategory);
+		HashName(Builder, PinType.PinSubCategory);
+		HashObjectPath(Builder, PinType.PinSubCategoryObject.Get());
+		HashValue(Builder, PinType.ContainerType);
+		HashValue(Builder, PinType.bIsReference);
+		HashValue(Builder, PinType.bIsConst);
+		HashName(Builder, PinType.PinValueType.TerminalCategory);
+		HashName(Builder, PinType.PinValueType.TerminalSubCategory);
+		HashObjectPath(Builder, PinType.PinValueType.TerminalSubCategoryObject.Get());
+	}
+	
+	void HashProperty(FXxHash64Builder& Builder, const FProperty* Property)
+	{
+		FString ExtendedType;
+		
+		HashName(Builder, Property->GetFName());
+		HashString(Builder, Property->GetCPPType(&ExtendedType));
+		HashString(Builder, ExtendedType);
+		HashValue(Builder, Property->PropertyFlags);
+	}
+	
+	// What other graphs compile against: property types and function signatures, not function bodies
+	void HashStructInterface(FXxHash64Builder& Builder, const UStruct* Struct)
+	{
+		HashObjectPath(Builder, Struct);
+		HashObjectPath(Builder, Struct->GetSuperStruct());
+		
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			HashProperty(Builder, *It);
+		}
+		
+		for (TFieldIterator<UFunction> It(Struct); It; ++It)
+		{
+			HashName(Builder, It->GetFName());
+			HashValue(Builder, It->FunctionFlags);
+			
+			for (TFieldIterator<FProperty> ParamIt(*It); ParamIt && ParamIt->HasAnyPropertyFlags(CPF_Parm); ++ParamIt)
+			{
+				HashProperty(Builder, *ParamIt);
+			}
+		}
+	}
+	
+	void HashExpansionVersion(FXxHash64Builder& Builder, const UClass* NodeClass)
+	{
+		// Every class in the chain contributes, so a change to a shared base class's expansion invalidates all of its subclasses
+		for (const UClass* Class = NodeClass; Class; Class = Class->GetSuperClass())
+		{
+			if (const FString* ExpansionVersion = Class->FindMetaData(ExpansionVersionKey))
+			{
+				HashString(Builder, *ExpansionVersion);
+			}
+		}
+	}
+	
+	void HashNode(FXxHash64Builder& Builder, const UEdGraphNode* Node)
+	{
+		HashObjectPath(Builder, Node->GetClass());
+		HashExpansionVersion(Builder, Node->GetClass());
+		HashValue(Builder, Node->NodeGuid);
+		HashValue(Builder, Node->GetDesiredEnabledState());
+		
+		// Node specific settings (function references, variable references, etc.). UEdGraphNode's own properties are all cosmetic.
+		FString ExportedValue;
+		
+		for (TFieldIterator<FProperty> It(Node->GetClass()); It; ++It)
+		{
+			if (It->GetOwnerClass() == UEdGraphNode::StaticClass() || It->HasAnyPropertyFlags(CPF_Transient))
+			{
+				continue;
+			}
+			
+			for (int32 i = 0; i < It->ArrayDim; ++i)
+			{
+				ExportedValue.Reset();
+				It->ExportText_InContainer(i, ExportedValue, Node, nullptr, const_cast<UEdGraphNode*>(Node), PPF_None);
+				
+				HashName(Builder, It->GetFName());
+				HashString(Builder, ExportedValue);
+			}
+		}
+		
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			HashName(Builder, Pin->PinName);
+			HashValue(Builder, Pin->Direction);
+			HashValue(Builder, Pin->bOrphanedPin);
+			HashPinType(Builder, Pin->PinType);
+			HashString(Builder, Pin->DefaultValue);
+			HashObjectPath(Builder, Pin->DefaultObject);
+			HashString(Builder, Pin->DefaultTextValue.ToString());
+			
+			HashValue(Builder, Pin->LinkedTo.Num());
+			
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				HashValue(Builder, LinkedPin->GetOwningNode()->NodeGuid);
+				HashName(Builder, LinkedPin->PinName);
+			}
+		}
+	}
+}
+#endif
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+void UBangoScriptBlueprint::BroadcastCompiled()
+{
+	// Regenerating on load doesn't count, the saved hash has to keep describing what was last compiled and saved. Failed compiles keep the old hash so the
+	// next pass tries again.
+	if (!bIsRegeneratingOnLoad && Status != BS_Error)
+	{
+		CompiledGraphHash = ComputeGraphHash();
+	}
+	
+	Super::BroadcastCompiled();
+}
+#endif
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+uint64 UBangoScriptBlueprint::ComputeGraphHash() const
+{
+	using namespace Bango::GraphHash;
+	
+	FXxHash64Builder Builder;
+	
+	HashValue(Builder, Bango::GraphHash::Version);
+	HashValue(Builder, FEngineVersion::Current().GetChangelist());
+	HashObjectPath(Builder, ParentClass);
+	
+	for (const FBPInterfaceDescription& InterfaceDesc : ImplementedInterfaces)
+	{
+		HashObjectPath(Builder, InterfaceDesc.Interface);
+	}
+	
+	for (const FBPVariableDescription& Variable : NewVariables)
+	{
+		HashName(Builder, Variable.VarName);
+		HashPinType(Builder, Variable.VarType);
+		HashString(Builder, Variable.DefaultValue);
+		HashValue(Builder, Variable.PropertyFlags);
+	}
+	
+	TArray<UEdGraph*> Graphs;
+	GetAllGraphs(Graphs);
+	
+	// Sort everything so that the hash doesn't depend on the order things were created or loaded in
+	Graphs.Sort([] (const UEdGraph& A, const UEdGraph& B) { return A.GetName() < B.GetName(); });
+	
+	TArray<const UEdGraphNode*> Nodes;
+	
+	for (const UEdGraph* Graph : Graphs)
+	{
+		HashName(Builder, Graph->GetFName());
+		HashObjectPath(Builder, Graph->Schema);
+		
+		Nodes.Reset(Graph->Nodes.Num());
+		
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node)
+			{
+				Nodes.Add(Node);
+			}
+		}
+		
+		Nodes.Sort([] (const UEdGraphNode& A, const UEdGraphNode& B) { return A.NodeGuid < B.NodeGuid; });
+		
+		HashValue(Builder, Nodes.Num());
+		
+		for (const UEdGraphNode* Node : Nodes)
+		{
+			HashNode(Builder, Node);
+		}
+	}
+	
+	// Other blueprints and user structs the graphs reference (other scripts' inputs, called functions, variable types...). A change to their interface
+	// changes what this script compiles to even if its own graphs are untouched.
+	TSet<TWeakObjectPtr<UBlueprint>> DependencyBlueprints;
+	TSet<TWeakObjectPtr<UStruct>> DependencyStructs;
+	FBlueprintEditorUtils::GatherDependencies(this, DependencyBlueprints, DependencyStructs);
+	
+	TArray<const UStruct*> Dependencies;
+	
+	for (const TWeakObjectPtr<UBlueprint>& DependencyBlueprint : DependencyBlueprints)
+	{
+		const UBlueprint* Blueprint = DependencyBlueprint.Get();
+		
+		if (!Blueprint || Blueprint == this)
+		{
+			continue;
+		}
+		
+		// The skeleton class is what dependents compile against, and it's kept up to date while the generated class waits for a compile
+		if (const UClass* DependencyClass = Blueprint->SkeletonGeneratedClass ? Blueprint->SkeletonGeneratedClass : Blueprint->GeneratedClass)
+		{
+			Dependencies.Add(DependencyClass);
+		}
+	}
+	
+	for (const TWeakObjectPtr<UStruct>& DependencyStruct : DependencyStructs)
+	{
+		if (const UStruct* Struct = DependencyStruct.Get())
+		{
+			Dependencies.Add(Struct);
+		}
+	}
+	
+	Dependencies.Sort([] (const UStruct& A, const UStruct& B) { return A.GetPathName() < B.GetPathName(); });
+	
+	HashValue(Builder, Dependencies.Num());
+	
+	for (const UStruct* Dependency : Dependencies)
+	{
+		HashStructInterface(Builder, Dependency);
+	}
+	
+	// Zero is reserved for "never compiled"
+	return FMath::Max<uint64>(Builder.Finalize().Hash, 1);
+}
+#endif
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+bool UBangoScriptBlueprint::IsCompiledGraphUpToDate() const
+{
+	if (!GeneratedClass || (Status != BS_UpToDate && Status != BS_UpToDateWithWarnings))
+	{
+		return false;
+	}
+	
+	return CompiledGraphHash != 0 && CompiledGraphHash == ComputeGraphHash();
+}
+#endif
+
+// ----------------------------------------------
+
 #if WITH_EDITOR
 UBangoScriptBlueprint* UBangoScriptBlueprint::GetBangoScriptBlueprintFromClass(const TSoftClassPtr<UBangoScript> ScriptClass)
 {
@@ -3,6 +3,7 @@
 #include "BangoScripts/Core/BangoScript.h"
 #include "BangoScripts/Utility/BangoScriptsLog.h"
 #include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -47,6 +48,71 @@ void FBangoScriptContainer::ClearActorRefs()
 {
 	SoftActorRefs.Empty();
 	HardActorRefs.Empty();
+	StreamingHintActorRefs.Empty();
+}
+#endif
+
+// ----------------------------------------------
+
+bool FBangoScriptContainer::AreStreamingHintsLoaded() const
+{
+	for (const FBangoStreamingHintActorRef& Hint : StreamingHintActorRefs)
+	{
+		if (!Hint.Actor.IsNull() && !Hint.Actor.IsValid())
+		{
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+// ----------------------------------------------
+
+bool FBangoScriptContainer::HasStreamingHint(const TSoftObjectPtr<AActor>& Actor) const
+{
+	return StreamingHintActorRefs.ContainsByPredicate([&Actor] (const FBangoStreamingHintActorRef& Hint) { return Hint.Actor == Actor; });
+}
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+void FBangoScriptContainer::AddStreamingHint(AActor* Actor)
+{
+	check(Actor);
+	
+	if (HasStreamingHint(Actor))
+	{
+		return;
+	}
+	
+	FBangoStreamingHintActorRef& Hint = StreamingHintActorRefs.AddDefaulted_GetRef();
+	Hint.Actor = Actor;
+	Hint.Location = Actor->GetActorLocation();
+}
+#endif
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+bool FBangoScriptContainer::RemoveStreamingHint(const TSoftObjectPtr<AActor>& Actor)
+{
+	return StreamingHintActorRefs.RemoveAll([&Actor] (const FBangoStreamingHintActorRef& Hint) { return Hint.Actor == Actor; }) > 0;
+}
+#endif
+
+// ----------------------------------------------
+
+#if WITH_EDITOR
+void FBangoScriptContainer::RefreshStreamingHintLocations()
+{
+	for (FBangoStreamingHintActorRef& Hint : StreamingHintActorRefs)
+	{
+		if (const AActor* Actor = Hint.Actor.Get())
+		{
+			Hint.Location = Actor->GetActorLocation();
+		}
+	}
 }
 #endif
 
@@ -2,8 +2,23 @@
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
+FBangoSleepAction* FBangoSleepAction::PollingAction = nullptr;
+
 void FBangoSleepAction::UpdateOperation(FLatentResponse& Response)
 {
+	// Poll the node's condition pins first so that this frame's pause/skip/cancel state applies immediately
+	if (OnTick.IsBound())
+	{
+		TGuardValue<FBangoSleepAction*> PollingGuard(PollingAction, this);
+		OnTick.Broadcast();
+	}
+	
+	if (bCancelled)
+	{
+		Response.DoneIf(true);
+		return;
+	}
+	
 	bool bIsSleepFinished = false;
 	
 	if (Duration >= 0.0f)
@@ -20,20 +35,11 @@ void FBangoSleepAction::UpdateOperation(FLatentResponse& Response)
 		bIsSleepFinished = bSkipped;
 	}
 
-	bIsSleepFinished |= bCancelled;
-
 	Response.FinishAndTriggerIf(bIsSleepFinished, ExecutionFunction, OutputLink, CallbackTarget);
 
 	if (bIsSleepFinished)
 	{
-		if (!bCancelled)
-		{
-			OnComplete.Broadcast();
-		}
-	}
-	else
-	{
-		OnTick.Broadcast();
+		OnComplete.Broadcast();
 	}
 }
 
@@ -59,6 +65,21 @@ void FBangoSleepAction::SetPaused(bool bInPaused)
 	bPaused = bInPaused;
 }
 
+void FBangoSleepAction::ApplyConditions(bool bSkip, bool bCancel, bool bInPaused)
+{
+	if (bCancel && !bCancelled)
+	{
+		Cancel();
+	}
+	
+	if (bSkip && !bSkipped)
+	{
+		Skip();
+	}
+	
+	SetPaused(bInPaused);
+}
+
 #if WITH_EDITOR
 FString FBangoSleepAction::GetDescription() const
 {
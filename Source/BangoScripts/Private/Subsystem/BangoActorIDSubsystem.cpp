@@ -1,6 +1,8 @@
 ﻿#include "BangoScripts/Subsystem/BangoActorIDSubsystem.h"
 
+#include "BangoScripts/Core/BangoActorIDTable.h"
 #include "BangoScripts/Utility/BangoScriptsLog.h"
+#include "Engine/Level.h"
 #include "Engine/World.h"
 
 UBangoActorIDSubsystem* UBangoActorIDSubsystem::Get(UObject* WorldContext)
@@ -21,6 +23,35 @@ UBangoActorIDSubsystem* UBangoActorIDSubsystem::Get(UObject* WorldContext)
 void UBangoActorIDSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+	
+	// Only cooked levels carry baked ID tables; uncooked worlds still register through UBangoActorIDComponent::BeginPlay
+	if (FPlatformProperties::RequiresCookedData())
+	{
+		FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::OnLevelAddedToWorld);
+		FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::OnLevelRemovedFromWorld);
+	}
+}
+
+void UBangoActorIDSubsystem::PostInitialize()
+{
+	Super::PostInitialize();
+	
+	if (FPlatformProperties::RequiresCookedData())
+	{
+		// The persistent level never fires LevelAddedToWorld
+		for (ULevel* Level : GetWorld()->GetLevels())
+		{
+			RegisterBakedLevel(Level);
+		}
+	}
+}
+
+void UBangoActorIDSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+	FWorldDelegates::LevelRemovedFromWorld.RemoveAll(this);
+	
+	Super::Deinitialize();
 }
 
 bool UBangoActorIDSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
@@ -28,6 +59,71 @@ bool UBangoActorIDSubsystem::DoesSupportWorldType(const EWorldType::Type WorldTy
 	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
 }
 
+void UBangoActorIDSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		RegisterBakedLevel(Level);
+	}
+}
+
+void UBangoActorIDSubsystem::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	// A null level means the whole world is being torn down, nothing to do
+	if (Level && World == GetWorld())
+	{
+		UnregisterBakedLevel(Level);
+	}
+}
+
+void UBangoActorIDSubsystem::RegisterBakedLevel(ULevel* Level)
+{
+	UBangoActorIDTable* Table = UBangoActorIDTable::Get(Level);
+	
+	if (!Table)
+	{
+		return;
+	}
+	
+	bool bAlreadyRegistered;
+	BakedLevels.Add(Level, &bAlreadyRegistered);
+	
+	if (bAlreadyRegistered)
+	{
+		return;
+	}
+	
+	for (const FBangoActorIDTableEntry& Entry : Table->GetEntries())
+	{
+		if (IsValid(Entry.Actor))
+		{
+			RegisterActor(this, Entry.Actor, Entry.Name, Entry.Guid);
+		}
+	}
+}
+
+void UBangoActorIDSubsystem::UnregisterBakedLevel(ULevel* Level)
+{
+	if (BakedLevels.Remove(Level) == 0)
+	{
+		return;
+	}
+	
+	UBangoActorIDTable* Table = UBangoActorIDTable::Get(Level);
+	check(Table);
+	
+	for (const FBangoActorIDTableEntry& Entry : Table->GetEntries())
+	{
+		FNameRegistration* Registration = ActorsByGuid.Find(Entry.Guid);
+		
+		// Registration may have been refused (duplicate guid/name) or belong to someone else
+		if (Registration && Registration->Key == Entry.Actor)
+		{
+			UnregisterActor(this, Entry.Guid);
+		}
+	}
+}
+
 void UBangoActorIDSubsystem::RegisterActor(UObject* WorldContextObject, AActor* Actor, FName Name, FGuid Guid)
 {
 	UBangoActorIDSubsystem* Subsystem = Get(WorldContextObject);
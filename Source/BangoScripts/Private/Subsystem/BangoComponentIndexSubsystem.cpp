@@ -0,0 +1,187 @@
+﻿#include "BangoScripts/Subsystem/BangoComponentIndexSubsystem.h"
+
+#include "BangoScripts/Components/BangoActorIDComponent.h"
+#include "BangoScripts/Components/BangoScriptComponent.h"
+#include "BangoScripts/Utility/BangoScriptsLog.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+// ----------------------------------------------
+
+UBangoComponentIndexSubsystem* UBangoComponentIndexSubsystem::Get(const UObject* WorldContext)
+{
+	if (!WorldContext)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContext->GetWorld();
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	return World->GetSubsystem<UBangoComponentIndexSubsystem>();
+}
+
+// ----------------------------------------------
+
+bool UBangoComponentIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType != EWorldType::None && WorldType != EWorldType::Inactive;
+}
+
+// ----------------------------------------------
+
+void UBangoComponentIndexSubsystem::RegisterComponent(UBangoActorIDComponent* Component)
+{
+	check(Component);
+
+	AActor* Owner = Component->GetOwner();
+	UBangoComponentIndexSubsystem* Subsystem = Get(Component);
+
+	if (!Owner || !Subsystem || Component->IsTemplate())
+	{
+		return;
+	}
+
+	FBangoIndexedActorComponents& Entry = Subsystem->ComponentsByActor.FindOrAdd(Owner);
+
+	if (Entry.IDComponent.IsValid() && Entry.IDComponent != Component)
+	{
+		UE_LOG(LogBango, Error, TEXT("Actor %s has more than one ID component!"), *Owner->GetName());
+		return;
+	}
+
+	Entry.IDComponent = Component;
+}
+
+// ----------------------------------------------
+
+void UBangoComponentIndexSubsystem::UnregisterComponent(UBangoActorIDComponent* Component)
+{
+	check(Component);
+
+	UBangoComponentIndexSubsystem* Subsystem = Get(Component);
+
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	TObjectKey<AActor> OwnerKey(Component->GetOwner());
+	FBangoIndexedActorComponents* Entry = Subsystem->ComponentsByActor.Find(OwnerKey);
+
+	if (!Entry || Entry->IDComponent != Component)
+	{
+		return;
+	}
+
+	Entry->IDComponent.Reset();
+
+	if (Entry->IsEmpty())
+	{
+		Subsystem->ComponentsByActor.Remove(OwnerKey);
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoComponentIndexSubsystem::RegisterComponent(UBangoScriptComponent* Component)
+{
+	check(Component);
+
+	AActor* Owner = Component->GetOwner();
+	UBangoComponentIndexSubsystem* Subsystem = Get(Component);
+
+	if (!Owner || !Subsystem || Component->IsTemplate())
+	{
+		return;
+	}
+
+	Subsystem->ComponentsByActor.FindOrAdd(Owner).ScriptComponents.AddUnique(Component);
+}
+
+// ----------------------------------------------
+
+void UBangoComponentIndexSubsystem::UnregisterComponent(UBangoScriptComponent* Component)
+{
+	check(Component);
+
+	UBangoComponentIndexSubsystem* Subsystem = Get(Component);
+
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	TObjectKey<AActor> OwnerKey(Component->GetOwner());
+	FBangoIndexedActorComponents* Entry = Subsystem->ComponentsByActor.Find(OwnerKey);
+
+	if (!Entry)
+	{
+		return;
+	}
+
+	Entry->ScriptComponents.RemoveSingleSwap(Component);
+
+	if (Entry->IsEmpty())
+	{
+		Subsystem->ComponentsByActor.Remove(OwnerKey);
+	}
+}
+
+// ----------------------------------------------
+
+UBangoActorIDComponent* UBangoComponentIndexSubsystem::GetActorIDComponent(const AActor* Actor)
+{
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	UBangoComponentIndexSubsystem* Subsystem = Get(Actor);
+
+	if (!Subsystem)
+	{
+		return Actor->FindComponentByClass<UBangoActorIDComponent>();
+	}
+
+	const FBangoIndexedActorComponents* Entry = Subsystem->ComponentsByActor.Find(Actor);
+
+	return Entry ? Entry->IDComponent.Get() : nullptr;
+}
+
+// ----------------------------------------------
+
+void UBangoComponentIndexSubsystem::ForEachScriptComponent(const AActor* Actor, TFunctionRef<void(UBangoScriptComponent*)> Func)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	UBangoComponentIndexSubsystem* Subsystem = Get(Actor);
+
+	if (!Subsystem)
+	{
+		Actor->ForEachComponent<UBangoScriptComponent>(false, Func);
+		return;
+	}
+
+	const FBangoIndexedActorComponents* Entry = Subsystem->ComponentsByActor.Find(Actor);
+
+	if (!Entry)
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<UBangoScriptComponent>& ScriptComponent : Entry->ScriptComponents)
+	{
+		if (UBangoScriptComponent* Component = ScriptComponent.Get())
+		{
+			Func(Component);
+		}
+	}
+}
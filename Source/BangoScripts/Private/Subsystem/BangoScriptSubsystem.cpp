@@ -1,7 +1,9 @@
 ﻿#include "BangoScripts/Subsystem/BangoScriptSubsystem.h"
 
+#include "BangoScripts/Actors/BangoInitScriptActor.h"
 #include "BangoScripts/Core/BangoScriptHandle.h"
 #include "BangoScripts/Core/BangoScript.h"
+#include "BangoScripts/Subsystem/BangoComponentIndexSubsystem.h"
 #include "BangoScripts/Utility/BangoScriptsLog.h"
 #include "Engine/AssetManager.h"
 #include "Engine/LatentActionManager.h"
@@ -155,6 +157,35 @@ FBangoScriptHandle UBangoScriptSubsystem::EnqueueScript(TSoftClassPtr<UBangoScri
 
 // ----------------------------------------------
 
+FBangoScriptHandle UBangoScriptSubsystem::RunScript(TSubclassOf<UBangoScript> ScriptClass, UObject* Runner, FInstancedPropertyBag&& Inputs, const FOnRunScriptFinished& OnFinished)
+{
+	if (!ScriptClass)
+	{
+		UE_LOG(LogBango, Verbose, TEXT("RunScript called with null script!"));
+		return FBangoScriptHandle::GetNullHandle();
+	}
+	
+	check(Runner);
+	
+	UBangoScriptSubsystem* Subsystem = Get(Runner);
+	
+	if (!Subsystem)
+	{
+		UE_LOG(LogBango, Error, TEXT("Could not find script subsystem; RunScript failure, runner: %s"), *Runner->GetPathName());
+		return FBangoScriptHandle::GetNullHandle();
+	}
+	
+	FBangoScriptHandle NewHandle = FBangoScriptHandle::NewHandle();
+	
+	FBangoQueuedScript& QueuedScript = Subsystem->QueuedScripts.Emplace_GetRef(Runner, nullptr, TSoftClassPtr<UBangoScript>(ScriptClass.Get()), NewHandle);
+	QueuedScript.OwnedPropertyBag = MoveTemp(Inputs);
+	QueuedScript.OnFinished = OnFinished;
+	
+	return NewHandle;
+}
+
+// ----------------------------------------------
+
 void UBangoScriptSubsystem::AbortScript(UObject* Requester, FBangoScriptHandle& Handle)
 {
 	if (!Handle.IsRunning())
@@ -209,6 +240,182 @@ void UBangoScriptSubsystem::RegisterOnScriptFinished(UObject* WorldContext, FBan
 
 // ----------------------------------------------
 
+void UBangoScriptSubsystem::RegisterInitScriptActor(ABangoInitScriptActor* Actor)
+{
+	check(Actor);
+	
+	UBangoScriptSubsystem* Subsystem = Get(Actor);
+	ULevel* Level = Actor->GetLevel();
+	
+	if (!Subsystem || !Level)
+	{
+		return;
+	}
+	
+	FBangoLevelInitScripts& LevelInitScripts = Subsystem->InitScriptsByLevel.FindOrAdd(Level);
+	
+	// Runs as soon as it initializes, see LaunchInitScripts
+	if (LevelInitScripts.bLaunched)
+	{
+		UE_LOG(LogBango, Verbose, TEXT("Init script actor %s was added to level %s after its init scripts launched, running it on its own"), *Actor->GetName(), *Level->GetPathName());
+	}
+	
+	auto LaunchesBefore = [] (const ABangoInitScriptActor& A, const ABangoInitScriptActor& B) -> bool
+	{
+		if (A.GetInitOrder() != B.GetInitOrder())
+		{
+			return A.GetInitOrder() < B.GetInitOrder();
+		}
+		
+		return A.GetFName().Compare(B.GetFName()) < 0;
+	};
+	
+	// Keep the list sorted as actors come in so lookups never need to sort
+	int32 InsertIndex = LevelInitScripts.Actors.Num();
+	
+	for (int32 i = 0; i < LevelInitScripts.Actors.Num(); ++i)
+	{
+		const ABangoInitScriptActor* Existing = LevelInitScripts.Actors[i].Get();
+		
+		if (Existing == Actor)
+		{
+			return;
+		}
+		
+		if (Existing && LaunchesBefore(*Actor, *Existing))
+		{
+			InsertIndex = i;
+			break;
+		}
+	}
+	
+	LevelInitScripts.Actors.Insert(Actor, InsertIndex);
+}
+
+// ----------------------------------------------
+
+void UBangoScriptSubsystem::UnregisterInitScriptActor(ABangoInitScriptActor* Actor)
+{
+	check(Actor);
+	
+	UBangoScriptSubsystem* Subsystem = Get(Actor);
+	
+	if (!Subsystem)
+	{
+		return;
+	}
+	
+	TObjectKey<ULevel> LevelKey(Actor->GetLevel());
+	FBangoLevelInitScripts* LevelInitScripts = Subsystem->InitScriptsByLevel.Find(LevelKey);
+	
+	if (!LevelInitScripts)
+	{
+		return;
+	}
+	
+	LevelInitScripts->Actors.Remove(Actor);
+	LevelInitScripts->LaunchedActors.Remove(Actor);
+	
+	// Dropping the entry also resets bLaunched, so a level that streams back in will run its init scripts again
+	if (LevelInitScripts->Actors.IsEmpty())
+	{
+		Subsystem->InitScriptsByLevel.Remove(LevelKey);
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoScriptSubsystem::GetInitScriptActors(ULevel* Level, TArray<ABangoInitScriptActor*>& OutActors)
+{
+	OutActors.Reset();
+	
+	UBangoScriptSubsystem* Subsystem = Get(Level);
+	
+	if (!Subsystem)
+	{
+		return;
+	}
+	
+	const FBangoLevelInitScripts* LevelInitScripts = Subsystem->InitScriptsByLevel.Find(Level);
+	
+	if (!LevelInitScripts)
+	{
+		return;
+	}
+	
+	OutActors.Reserve(LevelInitScripts->Actors.Num());
+	
+	for (const TWeakObjectPtr<ABangoInitScriptActor>& Actor : LevelInitScripts->Actors)
+	{
+		if (Actor.IsValid())
+		{
+			OutActors.Add(Actor.Get());
+		}
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoScriptSubsystem::LaunchInitScripts(ABangoInitScriptActor* Actor)
+{
+	check(Actor);
+	
+	UBangoScriptSubsystem* Subsystem = Get(Actor);
+	ULevel* Level = Actor->GetLevel();
+	
+	if (!Subsystem || !Level)
+	{
+		return;
+	}
+	
+	FBangoLevelInitScripts* LevelInitScripts = Subsystem->InitScriptsByLevel.Find(Level);
+	
+	if (!LevelInitScripts)
+	{
+		return;
+	}
+	
+	// Late registrant, the rest of the level already ran
+	if (LevelInitScripts->bLaunched)
+	{
+		RunInitScripts(*LevelInitScripts, Actor);
+		return;
+	}
+	
+	LevelInitScripts->bLaunched = true;
+	
+	TArray<ABangoInitScriptActor*> InitScriptActors;
+	GetInitScriptActors(Level, InitScriptActors);
+	
+	for (ABangoInitScriptActor* InitScriptActor : InitScriptActors)
+	{
+		RunInitScripts(*LevelInitScripts, InitScriptActor);
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoScriptSubsystem::RunInitScripts(FBangoLevelInitScripts& LevelInitScripts, ABangoInitScriptActor* Actor)
+{
+	bool bAlreadyLaunched = false;
+	LevelInitScripts.LaunchedActors.Add(Actor, &bAlreadyLaunched);
+	
+	if (bAlreadyLaunched)
+	{
+		return;
+	}
+	
+	UBangoComponentIndexSubsystem::ForEachScriptComponent(Actor, [] (UBangoScriptComponent* ScriptComponent)
+	{
+		if (ScriptComponent->GetRunOnBeginPlay())
+		{
+			ScriptComponent->Run();
+		}
+	});
+}
+
+// ----------------------------------------------
+
 void UBangoScriptSubsystem::Tick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
 {
 	UWorld* World = GetWorld();
@@ -302,12 +509,21 @@ void UBangoScriptSubsystem::LaunchQueuedScripts()
 			// TODO I should create these async, as part of the load process
 			UBangoScript* NewScriptInstance = NewObject<UBangoScript>(Outer, ScriptClass);
 			NewScriptInstance->Handle = QueuedScript.Handle;
-			NewScriptInstance->This = Runner; // The user is responsible to use the "This" node responsibly... If they destroy a trigger actor at the start of a script and then call 'This', well, I can't stop everything.
+			NewScriptInstance->SetThis(Runner); // The user is responsible to use the "This" node responsibly... If they destroy a trigger actor at the start of a script and then call 'This', well, I can't stop everything.
 			
 			if (QueuedScript.PropertyBag)
 			{
 				TransferPropertyBagToScriptInstance(QueuedScript.PropertyBag, NewScriptInstance);
 			}
+			else if (QueuedScript.OwnedPropertyBag.IsValid())
+			{
+				TransferPropertyBagToScriptInstance(&QueuedScript.OwnedPropertyBag, NewScriptInstance);
+			}
+			
+			if (QueuedScript.OnFinished.IsBound())
+			{
+				NewScriptInstance->OnFinishDelegate.Add(QueuedScript.OnFinished);
+			}
 			
 			RegisterScript(NewScriptInstance);
 			
@@ -328,6 +544,22 @@ void* ContainerVoidPtrToValuePtrInternal(const void* ContainerPtr, int32 Offset_
 	return (uint8*)ContainerPtr + Offset_Internal + static_cast<size_t>(ElementSize) * ArrayIndex;
 }
 
+// Property bags store every enum as an FEnumProperty, while blueprint enum variables are byte properties carrying the enum
+static bool IsSameInputType(const FProperty* ScriptProperty, const FProperty* BagProperty)
+{
+	if (ScriptProperty->SameType(BagProperty))
+	{
+		return true;
+	}
+	
+	const FByteProperty* ScriptByteProperty = CastField<FByteProperty>(ScriptProperty);
+	const FEnumProperty* BagEnumProperty = CastField<FEnumProperty>(BagProperty);
+	
+	return ScriptByteProperty && BagEnumProperty
+		&& ScriptByteProperty->Enum == BagEnumProperty->GetEnum()
+		&& BagEnumProperty->GetUnderlyingProperty()->IsA<FByteProperty>();
+}
+
 void UBangoScriptSubsystem::TransferPropertyBagToScriptInstance(const FInstancedPropertyBag* PropertyBag, UBangoScript* Script)
 {
     const UPropertyBag* PropertyBagStruct = PropertyBag->GetPropertyBagStruct();
@@ -351,6 +583,13 @@ void UBangoScriptSubsystem::TransferPropertyBagToScriptInstance(const FInstanced
 		
 		if (ScriptProperty && BagProperty)
 		{
+			// Inputs built against an older version of the script (e.g. by a stale Run Script node) can hold a value of another type or size
+			if (!IsSameInputType(ScriptProperty, BagProperty))
+			{
+				UE_LOG(LogBango, Warning, TEXT("Skipping input %s of script %s, its type does not match the script's property."), *ScriptPropertyName.ToString(), *Script->GetClass()->GetName());
+				continue;
+			}
+			
 			int32 Offset = BagProperty->GetOffset_ForInternal();
 			int32 ElementSize = BagProperty->GetElementSize();
 			
@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include "UObject/Object.h"
+
+#include "BangoSleepTestTarget.generated.h"
+
+/** Stands in for a script's ubergraph in the sleep tests; records every latent output link that gets triggered on it. */
+UCLASS(Transient, NotBlueprintable, HideDropdown)
+class UBangoSleepTestTarget : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	TArray<int32> TriggeredLinks;
+
+	UFUNCTION()
+	void OnSleepFinished(int32 Linkage)
+	{
+		TriggeredLinks.Add(Linkage);
+	}
+};
@@ -0,0 +1,130 @@
+﻿#include "BangoSleepTestTarget.h"
+
+#include "BangoScripts/Core/BangoScript.h"
+#include "BangoScripts/LatentActions/BangoSleepAction.h"
+#include "Engine/LatentActionManager.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Bango::SleepTests
+{
+	struct FSleepTestWorld
+	{
+		UWorld* World = nullptr;
+		UBangoSleepTestTarget* Target = nullptr;
+
+		FSleepTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			Target = NewObject<UBangoSleepTestTarget>(World);
+		}
+
+		~FSleepTestWorld()
+		{
+			World->DestroyWorld(false);
+		}
+
+		// Same info the compiler writes into the Sleep node's LatentInfo pin, one UUID per node
+		FLatentActionInfo MakeLatentInfo(int32 UUID, int32 Linkage) const
+		{
+			return FLatentActionInfo(Linkage, UUID, GET_FUNCTION_NAME_STRING_CHECKED(UBangoSleepTestTarget, OnSleepFinished), Target);
+		}
+
+		void Sleep(float Duration, EBangoSleepInput Input, const FLatentActionInfo& LatentInfo) const
+		{
+			UBangoScript::Sleep_Internal(Target, Duration, Input, FOnLatentActionTick(), LatentInfo);
+		}
+
+		FBangoSleepAction* FindAction(const FLatentActionInfo& LatentInfo) const
+		{
+			return World->GetLatentActionManager().FindExistingAction<FBangoSleepAction>(LatentInfo.CallbackTarget, LatentInfo.UUID);
+		}
+
+		void Tick(float DeltaTime) const
+		{
+			FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+			LatentActionManager.BeginFrame();
+			LatentActionManager.ProcessLatentActions(Target, DeltaTime);
+		}
+	};
+}
+
+// ------------------------------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBangoSleepCompletesAfterDurationTest, "BangoScripts.Sleep.CompletesAfterDuration", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FBangoSleepCompletesAfterDurationTest::RunTest(const FString& Parameters)
+{
+#if WITH_EDITOR
+	// The compiler only fills in LatentInfo and defers the Then pin for functions marked Latent
+	const UFunction* SleepFunction = UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, Sleep_Internal));
+	
+	if (!TestTrue(TEXT("Sleep_Internal is latent"), SleepFunction && SleepFunction->HasMetaData(TEXT("Latent"))))
+	{
+		return false;
+	}
+#endif
+	
+	Bango::SleepTests::FSleepTestWorld TestWorld;
+	const FLatentActionInfo LatentInfo = TestWorld.MakeLatentInfo(1, 7);
+	
+	TestWorld.Sleep(1.0f, EBangoSleepInput::Start, LatentInfo);
+	TestEqual(TEXT("Completed does not fire when the sleep starts"), TestWorld.Target->TriggeredLinks.Num(), 0);
+	TestNotNull(TEXT("Start registers an action under the node's UUID"), TestWorld.FindAction(LatentInfo));
+	
+	TestWorld.Tick(0.5f);
+	TestWorld.Tick(0.4f);
+	TestEqual(TEXT("Completed does not fire before Duration"), TestWorld.Target->TriggeredLinks.Num(), 0);
+	
+	TestWorld.Tick(0.2f);
+	TestEqual(TEXT("Completed fires once Duration has passed"), TestWorld.Target->TriggeredLinks, TArray<int32>{ 7 });
+	TestNull(TEXT("The finished action is removed"), TestWorld.FindAction(LatentInfo));
+	
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBangoSleepConcurrentSleepsTest, "BangoScripts.Sleep.ConcurrentSleepsAreIndependent", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FBangoSleepConcurrentSleepsTest::RunTest(const FString& Parameters)
+{
+	Bango::SleepTests::FSleepTestWorld TestWorld;
+	const FLatentActionInfo FirstInfo = TestWorld.MakeLatentInfo(1, 1);
+	const FLatentActionInfo SecondInfo = TestWorld.MakeLatentInfo(2, 2);
+	const FLatentActionInfo ThirdInfo = TestWorld.MakeLatentInfo(3, 3);
+	
+	TestWorld.Sleep(1.0f, EBangoSleepInput::Start, FirstInfo);
+	TestWorld.Sleep(2.0f, EBangoSleepInput::Start, SecondInfo);
+	TestWorld.Sleep(2.0f, EBangoSleepInput::Start, ThirdInfo);
+	
+	FBangoSleepAction* FirstAction = TestWorld.FindAction(FirstInfo);
+	FBangoSleepAction* SecondAction = TestWorld.FindAction(SecondInfo);
+	
+	if (!TestTrue(TEXT("Each sleep has its own action"), FirstAction && SecondAction && FirstAction != SecondAction))
+	{
+		return false;
+	}
+	
+	// A second Start on a running sleep keeps the running action
+	TestWorld.Sleep(5.0f, EBangoSleepInput::Start, FirstInfo);
+	TestTrue(TEXT("Start on a running sleep keeps its action"), TestWorld.FindAction(FirstInfo) == FirstAction);
+	
+	// Cancelling one sleep leaves the others running
+	TestWorld.Sleep(0.0f, EBangoSleepInput::Cancel, ThirdInfo);
+	TestWorld.Tick(1.1f);
+	TestEqual(TEXT("Only the shorter sleep completes"), TestWorld.Target->TriggeredLinks, TArray<int32>{ 1 });
+	TestNull(TEXT("The cancelled sleep is removed"), TestWorld.FindAction(ThirdInfo));
+	TestNotNull(TEXT("The longer sleep is still running"), TestWorld.FindAction(SecondInfo));
+	
+	// Skipping the remaining sleep completes it without waiting out its duration
+	TestWorld.Sleep(0.0f, EBangoSleepInput::Skip, SecondInfo);
+	TestWorld.Tick(0.1f);
+	TestEqual(TEXT("The skipped sleep completes, the cancelled one never does"), TestWorld.Target->TriggeredLinks, TArray<int32>{ 1, 2 });
+	
+	return true;
+}
+
+#endif
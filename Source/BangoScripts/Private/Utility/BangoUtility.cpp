@@ -2,7 +2,7 @@
 
 #include "GameFramework/Actor.h"
 #include "BangoScripts/Components/BangoActorIDComponent.h"
-#include "BangoScripts/Utility/BangoScriptsLog.h"
+#include "BangoScripts/Subsystem/BangoComponentIndexSubsystem.h"
 
 #if WITH_EDITOR
 #include "BangoScripts/EditorTooling/BangoEditorDelegates.h"
@@ -15,31 +15,15 @@ UBangoActorIDComponent* Bango::Utilities::GetActorIDComponent(AActor* Actor, boo
 		return nullptr;
 	}
 	
-	UBangoActorIDComponent* IDComponent = nullptr;
+	UBangoActorIDComponent* IDComponent = UBangoComponentIndexSubsystem::GetActorIDComponent(Actor);
 	
-	TArray<UBangoActorIDComponent*> IDComponents;
-	Actor->GetComponents<UBangoActorIDComponent>(IDComponents);
-	
-	if (IDComponents.Num() == 0)
-	{
 #if WITH_EDITOR
-		if (bForceCreate)
-		{
-			FBangoEditorDelegates::RequestNewID.Broadcast(Actor);
-			Actor->GetComponents<UBangoActorIDComponent>(IDComponents);	
-		}
-#endif
-		return nullptr;
-	}
-
-	if (IDComponents.Num() == 1)
-	{
-		IDComponent = IDComponents[0];
-	}
-	else
+	if (!IDComponent && bForceCreate)
 	{
-		UE_LOG(LogBango, Error, TEXT("Actor has more than one ID component!"));
+		FBangoEditorDelegates::RequestNewID.Broadcast(Actor);
+		IDComponent = UBangoComponentIndexSubsystem::GetActorIDComponent(Actor);
 	}
+#endif
 	
 	return IDComponent;
 }
@@ -5,19 +5,28 @@
 #include "BangoInitScriptActor.generated.h"
 
 /**
- * The init script actor has two features:
- * 1) It comes with a Script Component already attached.
- * 2) It is added to the world by a menu entry which inserts it at the start of the level's actors array
- * (after AWorldSettings, so usually index [1]).
- *	  This guarantees that BeginPlay of the script has access to WorldSettings and also guarantees that this script will
- *	  start running before BeginPlay of all other actors.
- *	  
- *	  
+ * Init script actors register themselves with the script subsystem for their level in PreInitializeComponents. A level pre-initializes all of its actors
+ * before it initializes any, and initializes all of them before any begins play, so once the first of them reaches PostInitializeComponents the autoplay
+ * scripts of all of them are launched in InitOrder (ties broken by actor name), ahead of every other actor's BeginPlay. Their position in the level's
+ * actors array does not matter. Init script actors added to a level after that (e.g. spawned at runtime) run their scripts as soon as they initialize.
  */
 UCLASS(NotBlueprintable)
 class BANGOSCRIPTS_API ABangoInitScriptActor : public AActor
 {
 	GENERATED_BODY()
 	
-	void BeginPlay() override;
+protected:
+	/** Init scripts in the same level launch from lowest to highest order. */
+	UPROPERTY(Category = "Bango", EditAnywhere)
+	int32 InitOrder = 0;
+	
+public:
+	int32 GetInitOrder() const { return InitOrder; }
+	
+protected:
+	void PreInitializeComponents() override;
+	
+	void PostInitializeComponents() override;
+	
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
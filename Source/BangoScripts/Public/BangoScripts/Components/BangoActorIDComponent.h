@@ -8,6 +8,8 @@
 /**
  * Bango Actor ID Component MAY become deprecated! It was originally intended to be used for level scripts to be able to look up actors from the world. 
  * However, I since figured out how to create soft pointers to actors in the level scripts which seem to work better. Real-world testing required.
+ * 
+ * Level-placed instances are baked into their level's UBangoActorIDTable when cooking and are stripped from cooked builds.
  */
 UCLASS(HideCategories=("Navigation", "Tags", "Activation", "AssetUserData"), meta = (BlueprintSpawnableComponent))
 class BANGOSCRIPTS_API UBangoActorIDComponent : public UActorComponent
@@ -20,6 +22,12 @@ public:
 public:
 	FName GetBangoName() const { return BangoName; }
 	
+	const FGuid& GetBangoGuid() const { return BangoGuid; }
+	
+	bool NeedsLoadForClient() const override;
+	
+	bool NeedsLoadForServer() const override;
+	
 protected:
 	UPROPERTY(EditAnywhere, NonPIEDuplicateTransient, TextExportTransient)
 	FName BangoName;
@@ -30,6 +38,8 @@ protected:
 	UPROPERTY(EditAnywhere, NonPIEDuplicateTransient, TextExportTransient)
 	FGuid UnusedGuid;
 	
+	bool IsBakedIntoLevelTable() const;
+	
 #if WITH_EDITORONLY_DATA
 	UPROPERTY(Transient)
 	TObjectPtr<UTexture2D> IconTexture;
@@ -40,6 +50,10 @@ protected:
 
 	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
+	void OnRegister() override;
+
+	void OnUnregister() override;
+	
 #if WITH_EDITOR
 protected:
 	void PrintGuid(const FString& FuncName);
@@ -51,10 +65,6 @@ protected:
 public:
 	void SetBangoName(FName NewID);
 
-	void OnRegister() override;
-
-	void OnUnregister() override;
-
 	void DebugDrawEditor(UCanvas* Canvas, FVector ScreenLocation, float Alpha) const;
 	
 	void DebugDrawGame(UCanvas* Canvas, FVector ScreenLocation, float Alpha) const;
@@ -6,6 +6,8 @@
 #include "BangoScripts/Debug/BangoDebugDrawServiceBase.h"
 #include "BangoScripts/Interfaces/BangoScriptContainerObjectInterface.h"
 #include "Math/GenericOctreePublic.h"
+#include "Engine/TimerHandle.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
 
 #include "BangoScriptComponent.generated.h"
 
@@ -63,7 +65,7 @@ struct FBangoScriptComponent_BillboardSettings
 };
 
 UCLASS(meta = (BlueprintSpawnableComponent), HideCategories = ("Activation", "AssetUserData", "Cooking", "Navigation", "Tags", "ComponentTick", "Sockets", "ComponentReplication", "Replication"))
-class BANGOSCRIPTS_API UBangoScriptComponent : public UActorComponent, public IBangoScriptHolderInterface
+class BANGOSCRIPTS_API UBangoScriptComponent : public UActorComponent, public IBangoScriptHolderInterface, public IWorldPartitionStreamingSourceProvider
 {
 	GENERATED_BODY()
 	
@@ -72,13 +74,14 @@ public:
 	
 	void BeginPlay() override;
 	
-#if WITH_EDITOR
-public:
-	UFUNCTION()
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
 	void OnRegister() override;
 	
 	void OnUnregister() override;
 	
+#if WITH_EDITOR
+public:
 	// This is only used to spawn script assets for level instance added components
 	void OnComponentCreated() override;
 
@@ -145,8 +148,18 @@ protected:
 	UPROPERTY(Category = "Bango", AdvancedDisplay, EditAnywhere, meta = (Bitmask, BitmaskEnum = "/Script/BangoScripts.EBangoScriptComponentAllowedNetConfigs"))
 	uint8 AllowedNetConfigs;
 	
+	/** How long to wait for streaming hint actors to load before running the script anyway. */
+	UPROPERTY(Category = "Bango", AdvancedDisplay, EditAnywhere, meta = (ClampMin = 0.0, Units = "s"))
+	float StreamingHintTimeout = 10.0f;
+	
 	UPROPERTY(Transient)
 	FBangoScriptHandle RunningHandle;
+	
+	FTimerHandle StreamingHintTimer;
+	
+	double StreamingHintRequestTime = 0.0;
+	
+	bool bStreamingHintsRegistered = false;
 
 #if WITH_EDITORONLY_DATA
     UPROPERTY(Transient)
@@ -163,9 +176,24 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void Run();
 	
+	bool GetRunOnBeginPlay() const { return bRunOnBeginPlay; }
+	
 protected:
+	void EnqueueScript();
+	
 	void OnScriptFinished(FBangoScriptHandle FinishedHandle);
 	
+	// Registers this component as a World Partition streaming source over every streaming hint target, then runs once they are loaded
+	void RequestStreamingHints();
+	
+	void PollStreamingHints();
+	
+	void ReleaseStreamingHints();
+	
+	bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const override;
+	
+	const UObject* GetStreamingSourceOwner() override { return this; }
+	
 	bool ContextPassesAllowFlags() const;
 	
 #if WITH_EDITOR
@@ -188,8 +216,6 @@ public:
 	
 	const FBangoScriptHandle& GetRunningHandle() const { return RunningHandle; }
 	
-	bool GetRunOnBeginPlay() const { return bRunOnBeginPlay; }
-	
 	bool GetPreventExecution() const { return bPreventExecution; }
 	
 	FBangoScriptContainer& GetScriptContainer() override { return ScriptContainer; }
@@ -0,0 +1,56 @@
+﻿#pragma once
+
+#include "Engine/AssetUserData.h"
+
+#include "BangoActorIDTable.generated.h"
+
+class AActor;
+class ULevel;
+
+USTRUCT()
+struct FBangoActorIDTableEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<AActor> Actor = nullptr;
+
+	UPROPERTY()
+	FName Name = NAME_None;
+
+	UPROPERTY()
+	FGuid Guid;
+};
+
+/**
+ * Baked onto each ULevel (including World Partition generated cell levels) when it is cooked. Holds the name/guid of every level-placed
+ * UBangoActorIDComponent so that cooked builds can strip those components and register the actors in one go when the level is added to the world.
+ */
+UCLASS()
+class BANGOSCRIPTS_API UBangoActorIDTable : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	static UBangoActorIDTable* Get(ULevel* Level);
+
+	const TArray<FBangoActorIDTableEntry>& GetEntries() const { return Entries; }
+
+	bool Contains(const FGuid& Guid) const;
+
+	void PostLoad() override;
+
+#if WITH_EDITOR
+	// Gathers every ID component in the level and replaces the level's table with the result. Only intended to run while cooking.
+	static void BakeLevel(ULevel* Level);
+#endif
+
+protected:
+	UPROPERTY()
+	TArray<FBangoActorIDTableEntry> Entries;
+
+	// Guids of Entries; every ID component in the level asks the table about itself while cooking, so this has to be a hashed lookup
+	TSet<FGuid> EntryGuids;
+
+	void BuildEntryGuids();
+};
@@ -12,22 +12,50 @@ class UBangoScriptSubsystem;
 
 namespace BangoNodeBuilder
 {
-	struct BangoPauseSleep_Internal;
-	struct BangoSkipSleep_Internal;
-	struct BangoLaunchSleep_Internal;
-	struct BangoCancelSleep_Internal;
+	struct BangoRunScript_Internal;
+	struct BangoSleep_Internal;
+	struct BangoSetSleepConditions_Internal;
 	struct BangoExecuteScript_Internal;
 }
 
 DECLARE_DYNAMIC_DELEGATE_RetVal(bool, FWaitUntilDelegate);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFinishDelegate);
+DECLARE_DYNAMIC_DELEGATE(FOnRunScriptFinished);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLatentActionDelegate);
 DECLARE_DYNAMIC_DELEGATE(FOnLatentActionTick);
-DECLARE_DYNAMIC_DELEGATE(FOnLatentActionCompleted);
+
+/** Exec inputs of the Sleep node. All of them route into the same latent action. */
+UENUM()
+enum class EBangoSleepInput : uint8
+{
+	Start,
+	Skip,
+	Cancel,
+};
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
+/**
+ * Actor path baked into a script's class defaults by FindActor nodes. The path is stored pre-parsed and is deliberately not collected as a
+ * package reference, the same way UBangoScriptBlueprint stores its owner actor path, so that scripts do not drag levels into their dependencies.
+ */
+USTRUCT()
+struct BANGOSCRIPTS_API FBangoScriptActorRef
+{
+	GENERATED_BODY()
+	
+	FSoftObjectPath ActorPath;
+	
+	bool Serialize(FArchive& Ar);
+};
+
+template<>
+struct TStructOpsTypeTraits<FBangoScriptActorRef> : public TStructOpsTypeTraitsBase2<FBangoScriptActorRef>
+{
+	enum { WithSerializer = true };
+};
+
 using DataValidationDelegate = TDelegate<EDataValidationResult(class FDataValidationContext& Context, const UBangoScript* ScriptInstance)>;
 
 /**
@@ -41,12 +69,12 @@ class BANGOSCRIPTS_API UBangoScript : public UObject
     friend UBangoScriptValidator;
 	friend UBangoScriptSubsystem;
 	friend BangoNodeBuilder::BangoExecuteScript_Internal;
-	friend BangoNodeBuilder::BangoCancelSleep_Internal;
-	friend BangoNodeBuilder::BangoLaunchSleep_Internal;
-	friend BangoNodeBuilder::BangoSkipSleep_Internal;
-	friend BangoNodeBuilder::BangoPauseSleep_Internal;
+	friend BangoNodeBuilder::BangoSleep_Internal;
+	friend BangoNodeBuilder::BangoSetSleepConditions_Internal;
 	friend class UK2Node_BangoFinishScript;
-	friend class UK2Node_BangoRunScript;
+	friend BangoNodeBuilder::BangoRunScript_Internal;
+	friend class UK2Node_BangoFindActor;
+	friend class FBangoScriptCompilerContext;
     
 protected:
     // TODO: is this a bad decision? How else can I do this? Can I register things to keep scripts alive? Can I discover delegate subs in blueprints?
@@ -62,6 +90,19 @@ protected:
 	UPROPERTY(EditAnywhere, DisplayName = "'This' Class")
 	TSubclassOf<UObject> This_ClassType;
 	
+	/** Filled in at compile time, one name per 'This' class used by This nodes. Each is an object property the script compiler added to the generated class; SetThis fills them in on launch so This nodes read them without a cast. */
+	UPROPERTY()
+	TArray<FName> TypedThisProperties;
+	
+	// TypedThisProperties resolved against the generated class. Only filled in on the CDO, the first time an instance of the class launches.
+	TArray<FObjectPropertyBase*> ResolvedTypedThisProperties;
+	
+	bool bTypedThisPropertiesResolved = false;
+	
+	/** Filled in at compile time, one entry per actor referenced by FindActor nodes. */
+	UPROPERTY()
+	TArray<FBangoScriptActorRef> ActorRefTable;
+	
 #if WITH_EDITORONLY_DATA
 protected:
     UPROPERTY(EditAnywhere)
@@ -80,16 +121,28 @@ public:
 protected:
     bool GetKeepAliveWhenIdle() const { return bPreventAutoDestroy; }
     
+    // Sets This, plus every typed This property the runner is compatible with. The rest stay null, same as a failed cast.
+    void SetThis(UObject* Runner);
+    
+    // Called on the CDO, looks the typed This properties up once per class
+    const TArray<FObjectPropertyBase*>& GetResolvedTypedThisProperties();
+    
     /** This is implemented by designers. */
     UFUNCTION(BlueprintImplementableEvent)
     void Start();
 
+    /** Used by FindActor nodes; resolves an entry of ActorRefTable without any string parsing. */
+    UFUNCTION(BlueprintInternalUseOnly, BlueprintPure, meta = (BlueprintProtected))
+    AActor* GetActorRef(int32 Index) const;
+
     /** This is supposed to be called at the end of the Execute function */
     UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, meta = (WorldContext = "Script", BlueprintProtected))
     static void Finish(UBangoScript* Script);
 
 #if WITH_EDITOR
     bool ImplementsGetWorld() const override { return true; }
+    
+    void PostCDOCompiled(const FPostCDOCompiledContext& Context) override;
 #endif
     
 public:
@@ -105,23 +158,22 @@ protected:
     UPROPERTY(Transient)
     FBangoScriptHandle Handle;
 
-    UPROPERTY(Transient)
-    TMap<int32, FOnLatentActionTick> SleepTickDelegates;
+    // The whole RunScript node compiles to this one call. The variadic arguments are the values of the node's input pins, matched to
+    // InputNames in order; the subsystem creates the script, copies those into it and binds OnFinished when it launches it.
+    UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, CustomThunk, Category="Bango|Scripts", meta = (Variadic, AutoCreateRefTerm = "InputNames"))
+    FBangoScriptHandle RunScript_Internal(TSubclassOf<UBangoScript> ScriptClass, const TArray<FName>& InputNames, FOnRunScriptFinished OnFinished);
     
-	UPROPERTY(Transient)
-    TMap<int32, FOnLatentActionCompleted> SleepCancelDelegates;
-
-    UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, Category="Bango|Delay", meta = (WorldContext="WorldContextObject", LatentInfo="LatentInfo", Duration="1.23", Keywords="sleep"))
-    static UPARAM(DisplayName = "UUID") int32 LaunchSleep_Internal(const UObject* WorldContextObject, float Duration, struct FLatentActionInfo LatentInfo, FOnLatentActionTick TickDelegate, FOnLatentActionCompleted CompleteDelegate);
-
-    UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, Category="Bango|Delay", meta = (WorldContext="WorldContextObject", Keywords="sleep"))
-    static void CancelSleep_Internal(UObject* WorldContextObject, int32 ActionUUID);
-
-    UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, Category="Bango|Delay", meta = (WorldContext="WorldContextObject", Keywords="sleep"))
-    static void SkipSleep_Internal(UObject* WorldContextObject, int32 ActionUUID);
-
-    UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, Category="Bango|Delay", meta = (WorldContext="WorldContextObject", Keywords="sleep"))
-    static void SetSleepPause_Internal(UObject* WorldContextObject, bool bPaused, int32 ActionUUID);
+    DECLARE_FUNCTION(execRunScript_Internal);
+    
+    // The whole Sleep node compiles to this one call. Start launches the action, Skip/Cancel find it again through the node's latent UUID.
+    // TickDelegate is only bound when the node has condition pins, which then get polled through SetSleepConditions_Internal.
+    // Latent is required: without it the compiler neither fills in LatentInfo nor defers Then until the action finishes.
+    UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, Category="Bango|Delay", meta = (Latent, WorldContext="WorldContextObject", LatentInfo="LatentInfo", ExpandEnumAsExecs="Input", Duration="1.23", Keywords="sleep"))
+    static void Sleep_Internal(const UObject* WorldContextObject, float Duration, EBangoSleepInput Input, FOnLatentActionTick TickDelegate, struct FLatentActionInfo LatentInfo);
+
+    // Only valid while a sleep action is polling its tick delegate; applies to that action.
+    UFUNCTION(BlueprintInternalUseOnly, BlueprintCallable, Category="Bango|Delay", meta = (Keywords="sleep"))
+    static void SetSleepConditions_Internal(bool bSkip, bool bCancel, bool bPaused);
     
 #if WITH_EDITOR
     
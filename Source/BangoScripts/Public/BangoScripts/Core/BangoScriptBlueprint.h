@@ -47,6 +47,35 @@ public:
 	void Reset();
 	
 	TWeakObjectPtr<UObject> GetCurrentObjectBeingDebugged() const;
+	
+	// ------------------------------------------
+	// Compiled actor refs
+	// FindActor nodes register their target here while expanding. UBangoScript::PostCDOCompiled moves the result into the class defaults.
+	
+public:
+	int32 AddCompiledActorRef(const FSoftObjectPath& ActorPath);
+	
+	bool HasCompiledActorRefs() const { return !CompiledActorRefs.IsEmpty(); }
+	
+	TArray<FSoftObjectPath> ConsumeCompiledActorRefs();
+	
+protected:
+	TArray<FSoftObjectPath> CompiledActorRefs;
+
+	// ------------------------------------------
+	// Incremental compilation
+	// The graph hash of the last successful compile is saved with the blueprint, so that tooling can skip recompiling and resaving unchanged scripts.
+	
+public:
+	void BroadcastCompiled() override;
+	
+	// Hashes everything in the graphs that feeds into the compiled class, plus the interface of every blueprint and user struct they depend on. Node
+	// positions, comments and other cosmetic data are left out. Native types are only covered through the engine changelist, and user enums not at all;
+	// changing either in a project needs a forced recompile.
+	uint64 ComputeGraphHash() const;
+	
+	// True if the generated class is up to date and was compiled from the graphs as they are now.
+	bool IsCompiledGraphUpToDate() const;
 
 	// ------------------------------------------
 	// Delete/Undo support
@@ -102,5 +131,9 @@ protected:
 	*/
 	UPROPERTY(EditAnywhere, NonPIEDuplicateTransient, TextExportTransient)
 	FBangoScriptObjectPath ScriptHolderObjectPath;
+	
+	/* Result of ComputeGraphHash() at the last successful compile. Zero if the script was never compiled since this was added. */
+	UPROPERTY(DuplicateTransient, TextExportTransient)
+	uint64 CompiledGraphHash = 0;
 #endif
 };
@@ -9,6 +9,22 @@
 class UBangoScript;
 class UBangoScriptBlueprint;
 
+/**
+ * An actor reference that is not loaded together with the script owner. Instead, the owner requests streaming around the target just before it runs.
+ */
+USTRUCT()
+struct BANGOSCRIPTS_API FBangoStreamingHintActorRef
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(VisibleAnywhere)
+	TSoftObjectPtr<AActor> Actor;
+	
+	/** Where the actor was when the script owner was last saved. An unloaded actor has no location, so this is where streaming is requested. */
+	UPROPERTY(VisibleAnywhere)
+	FVector Location = FVector::ZeroVector;
+};
+
 /**
  * This struct is used to hold a script. It is used in ABangoTrigger and in UBangoScriptComponent.
  */
@@ -57,6 +73,18 @@ public:
 	UPROPERTY(EditInstanceOnly, AdvancedDisplay, DisplayName = "Hard Actor Refs (DEBUG VIEW)")
 	TSet<TObjectPtr<AActor>> HardActorRefs;
 	
+	/**
+	 * Alternative to HardActorRefs which keeps World Partition cells decoupled. These actors are streamed in on demand right before the script runs.
+	 * This property will be hidden at a later date after this feature is stable.
+	 */
+	UPROPERTY(EditInstanceOnly, AdvancedDisplay, DisplayName = "Streaming Hint Actor Refs (DEBUG VIEW)")
+	TArray<FBangoStreamingHintActorRef> StreamingHintActorRefs;
+	
+	// Returns true if every streaming hint target is currently loaded
+	bool AreStreamingHintsLoaded() const;
+	
+	bool HasStreamingHint(const TSoftObjectPtr<AActor>& Actor) const;
+	
 #if WITH_EDITORONLY_DATA
 protected:
 	// Used during construction of the ScriptClass only
@@ -86,6 +114,13 @@ public:
 	
 	void ClearActorRefs();
 	
+	void AddStreamingHint(AActor* Actor);
+	
+	bool RemoveStreamingHint(const TSoftObjectPtr<AActor>& Actor);
+	
+	// Re-records the location of every loaded streaming hint target
+	void RefreshStreamingHintLocations();
+	
 	void SetScriptClass(TSubclassOf<UObject> NewScriptClass);
 	
 	void UpdateScriptInputs();
@@ -42,6 +42,17 @@ public:
 
 	void SetPaused(bool bInPaused);
 
+	// Called from the owning script while OnTick is being broadcast, with the current values of the node's condition pins
+	void ApplyConditions(bool bSkip, bool bCancel, bool bInPaused);
+
+	static FBangoSleepAction* GetPollingAction() { return PollingAction; }
+
+protected:
+	// The action currently broadcasting OnTick. Game thread only.
+	static FBangoSleepAction* PollingAction;
+
+public:
+
 #if WITH_EDITOR
 	// Returns a human readable description of the latent operation's current state
 	FString GetDescription() const override;
@@ -2,6 +2,7 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "BangoActorIDSubsystem.generated.h"
 
@@ -21,6 +22,10 @@ protected:
 
 	void Initialize(FSubsystemCollectionBase& Collection) override;
 	
+	void PostInitialize() override;
+	
+	void Deinitialize() override;
+	
 	bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
 	
 protected:
@@ -28,6 +33,17 @@ protected:
 	
 	TMap<FGuid, FNameRegistration> ActorsByGuid;
 	
+	// Levels whose cooked UBangoActorIDTable has been registered
+	TSet<TObjectKey<ULevel>> BakedLevels;
+	
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+	
+	void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+	
+	void RegisterBakedLevel(ULevel* Level);
+	
+	void UnregisterBakedLevel(ULevel* Level);
+	
 public:
 	static void RegisterActor(UObject* WorldContextObject, AActor* Actor, FName Name, FGuid Guid);
 
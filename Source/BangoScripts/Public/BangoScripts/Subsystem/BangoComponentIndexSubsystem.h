@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "BangoComponentIndexSubsystem.generated.h"
+
+class AActor;
+class UBangoActorIDComponent;
+class UBangoScriptComponent;
+
+struct FBangoIndexedActorComponents
+{
+	TWeakObjectPtr<UBangoActorIDComponent> IDComponent;
+
+	TArray<TWeakObjectPtr<UBangoScriptComponent>, TInlineAllocator<1>> ScriptComponents;
+
+	bool IsEmpty() const { return !IDComponent.IsValid() && ScriptComponents.IsEmpty(); }
+};
+
+/**
+ * Keeps an Actor -> Bango component index, filled in as components register and unregister. Unlike the other Bango subsystems this also exists in
+ * editor worlds, since most lookups come from editor tooling. Lookups fall back to a component scan if the world has no subsystem (e.g. inactive worlds).
+ */
+UCLASS()
+class BANGOSCRIPTS_API UBangoComponentIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	static UBangoComponentIndexSubsystem* Get(const UObject* WorldContext);
+
+	bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+protected:
+	TMap<TObjectKey<AActor>, FBangoIndexedActorComponents> ComponentsByActor;
+
+public:
+	static void RegisterComponent(UBangoActorIDComponent* Component);
+
+	static void UnregisterComponent(UBangoActorIDComponent* Component);
+
+	static void RegisterComponent(UBangoScriptComponent* Component);
+
+	static void UnregisterComponent(UBangoScriptComponent* Component);
+
+	static UBangoActorIDComponent* GetActorIDComponent(const AActor* Actor);
+
+	static void ForEachScriptComponent(const AActor* Actor, TFunctionRef<void(UBangoScriptComponent*)> Func);
+};
@@ -1,14 +1,18 @@
 ﻿#pragma once
 
 #include "BangoScripts/Components/BangoScriptComponent.h"
+#include "BangoScripts/Core/BangoScript.h"
 #include "BangoScripts/Core/BangoScriptHandle.h"
 #include "BangoScripts/Utility/ObjectTicker.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "BangoScriptSubsystem.generated.h"
 
 struct FStreamableHandle;
 struct FBangoScriptHandle;
+class ABangoInitScriptActor;
+class ULevel;
 class UBangoScript;
 
 // ----------------------------------------------
@@ -39,6 +43,13 @@ struct FBangoQueuedScript
 	
 	TSharedPtr<FStreamableHandle> ScriptClassHandle;
 	
+	// Inputs owned by the queue entry itself, used when there is no external PropertyBag (RunScript nodes)
+	UPROPERTY(Transient)
+	FInstancedPropertyBag OwnedPropertyBag;
+	
+	UPROPERTY(Transient)
+	FOnRunScriptFinished OnFinished;
+	
 	void LoadAsync();
 
 	void LoadSync();
@@ -48,6 +59,19 @@ struct FBangoQueuedScript
 
 // ----------------------------------------------
 
+// Init script actors of a single level, kept sorted by launch order
+struct FBangoLevelInitScripts
+{
+	TArray<TWeakObjectPtr<ABangoInitScriptActor>> Actors;
+	
+	// Actors whose scripts have been run, so late registrants are only run once
+	TSet<TObjectKey<ABangoInitScriptActor>> LaunchedActors;
+	
+	bool bLaunched = false;
+};
+
+// ----------------------------------------------
+
 UCLASS()
 class UBangoScriptSubsystem : public UWorldSubsystem, public TObjectTicker<UBangoScriptSubsystem>
 {
@@ -65,6 +89,8 @@ protected:
 
 	TMulticastDelegate<void(FBangoScriptHandle)> OnScriptFinished;
 	
+	TMap<TObjectKey<ULevel>, FBangoLevelInitScripts> InitScriptsByLevel;
+	
 	bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
 	
 public:
@@ -77,11 +103,28 @@ public:
 	// Alternate usage for cases where I want external things to supply the handle - for example the ScriptComponent does this so that it can 
 	static FBangoScriptHandle EnqueueScript(TSoftClassPtr<UBangoScript> ScriptClass, UObject* Runner, const FInstancedPropertyBag* PropertyBag, bool bLoadImmediately = false);
 	
+	// Entry point for RunScript nodes. The script is created when the queue launches it, with Inputs copied onto it and OnFinished bound to its finish.
+	static FBangoScriptHandle RunScript(TSubclassOf<UBangoScript> ScriptClass, UObject* Runner, FInstancedPropertyBag&& Inputs, const FOnRunScriptFinished& OnFinished);
+	
 	static void AbortScript(UObject* Requester, FBangoScriptHandle& Handle);
 	
 	static void RegisterOnScriptFinished(UObject* WorldContext, FBangoScriptHandle RunningHandle, const TDelegate<void(FBangoScriptHandle)>& Delegate);
 	
+	// Init script actors register themselves before any actor in their level begins play
+	static void RegisterInitScriptActor(ABangoInitScriptActor* Actor);
+
+	static void UnregisterInitScriptActor(ABangoInitScriptActor* Actor);
+	
+	// Returns the level's init script actors in launch order (InitOrder, then name)
+	static void GetInitScriptActors(ULevel* Level, TArray<ABangoInitScriptActor*>& OutActors);
+	
+	// The first call for a level runs the autoplay scripts of every init script actor registered in it, in launch order. Later calls only run Actor's
+	// scripts, if it registered after the level launched.
+	static void LaunchInitScripts(ABangoInitScriptActor* Actor);
+	
 protected:
+	static void RunInitScripts(FBangoLevelInitScripts& LevelInitScripts, ABangoInitScriptActor* Actor);
+	
 	void Tick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
 	
 	void PruneFinishedScripts(UWorld* World);
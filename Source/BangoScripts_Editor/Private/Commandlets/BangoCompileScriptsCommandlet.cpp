@@ -0,0 +1,344 @@
+﻿#include "BangoCompileScriptsCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BangoScripts/Core/BangoScriptBlueprint.h"
+#include "BangoScripts/EditorTooling/BangoScriptsEditorLog.h"
+#include "HAL/FileManager.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+// ----------------------------------------------
+
+UBangoCompileScriptsCommandlet::UBangoCompileScriptsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+// ----------------------------------------------
+
+int32 UBangoCompileScriptsCommandlet::Main(const FString& Params)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	
+	int32 BatchSize = 64;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(1, BatchSize);
+	
+	int32 NumSlowestToReport = 20;
+	FParse::Value(*Params, TEXT("Top="), NumSlowestToReport);
+	
+	const bool bResave = FParse::Param(*Params, TEXT("Resave"));
+	const bool bForce = FParse::Param(*Params, TEXT("Force"));
+	
+	FString PathsParam;
+	FParse::Value(*Params, TEXT("Path="), PathsParam, false);
+	
+	TArray<FString> Paths;
+	PathsParam.ParseIntoArray(Paths, TEXT(","));
+	
+	// -----------------
+	// Discovery
+	
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+	
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBangoScriptBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(FName(Path));
+	}
+	
+	TArray<FAssetData> ScriptAssets;
+	AssetRegistry.GetAssets(Filter, ScriptAssets);
+	
+	if (ScriptAssets.IsEmpty())
+	{
+		UE_LOG(LogBangoEditor, Display, TEXT("No Bango script blueprints found"));
+		return 0;
+	}
+	
+	TArray<TArray<FAssetData>> Batches = BuildBatches(ScriptAssets, BatchSize);
+	
+	UE_LOG(LogBangoEditor, Display, TEXT("Compiling %i Bango script blueprints in %i batches"), ScriptAssets.Num(), Batches.Num());
+	
+	// -----------------
+	// Compile
+	
+	struct FScriptTiming
+	{
+		FName PackageName;
+		double Seconds;
+	};
+	
+	TArray<FScriptTiming> Timings;
+	Timings.Reserve(ScriptAssets.Num());
+	
+	int32 NumCompiled = 0;
+	int32 NumFailed = 0;
+	int32 NumWarnings = 0;
+	int32 NumResaved = 0;
+	int32 NumSkipped = 0;
+	double TotalLoadTime = 0.0;
+	double TotalCompileTime = 0.0;
+	
+	for (int32 BatchIndex = 0; BatchIndex < Batches.Num(); ++BatchIndex)
+	{
+		const TArray<FAssetData>& Batch = Batches[BatchIndex];
+		
+		// Let the async loader work on the whole batch at once; compiling has to stay on the game thread
+		const double LoadStartTime = FPlatformTime::Seconds();
+		
+		for (const FAssetData& Asset : Batch)
+		{
+			LoadPackageAsync(Asset.PackageName.ToString());
+		}
+		
+		FlushAsyncLoading();
+		
+		TotalLoadTime += FPlatformTime::Seconds() - LoadStartTime;
+		
+		for (const FAssetData& Asset : Batch)
+		{
+			UBangoScriptBlueprint* Blueprint = Cast<UBangoScriptBlueprint>(Asset.GetAsset());
+			
+			if (!Blueprint)
+			{
+				UE_LOG(LogBangoEditor, Error, TEXT("Failed to load %s"), *Asset.GetObjectPathString());
+				++NumFailed;
+				continue;
+			}
+			
+			if (!bForce && Blueprint->IsCompiledGraphUpToDate())
+			{
+				UE_LOG(LogBangoEditor, Verbose, TEXT("%s is unchanged since its last compile, skipping"), *Asset.PackageName.ToString());
+				++NumSkipped;
+				continue;
+			}
+			
+			FCompilerResultsLog Results;
+			Results.bSilentMode = true;
+			Results.bLogInfoOnly = false;
+			
+			const double CompileStartTime = FPlatformTime::Seconds();
+			
+			FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SkipSave, &Results);
+			
+			const double CompileTime = FPlatformTime::Seconds() - CompileStartTime;
+			TotalCompileTime += CompileTime;
+			Timings.Add( { Asset.PackageName, CompileTime } );
+			
+			NumWarnings += Results.NumWarnings;
+			
+			if (Results.NumErrors > 0 || Blueprint->Status == BS_Error)
+			{
+				++NumFailed;
+				
+				UE_LOG(LogBangoEditor, Error, TEXT("%s failed to compile (%i errors)"), *Asset.PackageName.ToString(), Results.NumErrors);
+				
+				for (const TSharedRef<FTokenizedMessage>& Message : Results.Messages)
+				{
+					if (Message->GetSeverity() == EMessageSeverity::Error)
+					{
+						UE_LOG(LogBangoEditor, Error, TEXT("    %s"), *Message->ToText().ToString());
+					}
+				}
+				
+				continue;
+			}
+			
+			++NumCompiled;
+			
+			UE_LOG(LogBangoEditor, Verbose, TEXT("%s compiled in %.2f ms"), *Asset.PackageName.ToString(), CompileTime * 1000.0);
+			
+			if (bResave && ResavePackage(Blueprint->GetPackage()))
+			{
+				++NumResaved;
+			}
+		}
+		
+		// Loaded assets are RF_Standalone, which GC keeps no matter what. Without clearing it every batch would stay in memory until the end.
+		for (const FAssetData& Asset : Batch)
+		{
+			if (UPackage* Package = FindPackage(nullptr, *Asset.PackageName.ToString()))
+			{
+				ForEachObjectWithPackage(Package, [] (UObject* Object)
+				{
+					Object->ClearFlags(RF_Standalone);
+					return true;
+				});
+			}
+		}
+		
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		
+		UE_LOG(LogBangoEditor, Display, TEXT("Batch %i/%i done (%i scripts)"), BatchIndex + 1, Batches.Num(), Batch.Num());
+	}
+	
+	// -----------------
+	// Report
+	
+	Timings.Sort([] (const FScriptTiming& A, const FScriptTiming& B) { return A.Seconds > B.Seconds; });
+	
+	UE_LOG(LogBangoEditor, Display, TEXT("Slowest scripts:"));
+	
+	for (int32 i = 0; i < FMath::Min(NumSlowestToReport, Timings.Num()); ++i)
+	{
+		UE_LOG(LogBangoEditor, Display, TEXT("    %8.2f ms  %s"), Timings[i].Seconds * 1000.0, *Timings[i].PackageName.ToString());
+	}
+	
+	UE_LOG(LogBangoEditor, Display, TEXT("Compiled %i scripts, failed %i, in %.2f s (load %.2f s, compile %.2f s): %i warnings, %i resaved, %i unchanged"),
+		NumCompiled, NumFailed, FPlatformTime::Seconds() - StartTime, TotalLoadTime, TotalCompileTime, NumWarnings, NumResaved, NumSkipped);
+	
+	return NumFailed > 0 ? 1 : 0;
+}
+
+// ----------------------------------------------
+
+TArray<TArray<FAssetData>> UBangoCompileScriptsCommandlet::BuildBatches(const TArray<FAssetData>& ScriptAssets, int32 BatchSize)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	
+	TMap<FName, int32> IndexByPackage;
+	IndexByPackage.Reserve(ScriptAssets.Num());
+	
+	for (int32 i = 0; i < ScriptAssets.Num(); ++i)
+	{
+		IndexByPackage.Add(ScriptAssets[i].PackageName, i);
+	}
+	
+	// Only dependencies on other scripts in the set matter for ordering
+	TArray<int32> NumPendingDependencies;
+	NumPendingDependencies.SetNumZeroed(ScriptAssets.Num());
+	
+	TArray<TArray<int32>> Dependents;
+	Dependents.SetNum(ScriptAssets.Num());
+	
+	TArray<FName> Dependencies;
+	
+	for (int32 i = 0; i < ScriptAssets.Num(); ++i)
+	{
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(ScriptAssets[i].PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+		
+		for (const FName& Dependency : Dependencies)
+		{
+			const int32* DependencyIndex = IndexByPackage.Find(Dependency);
+			
+			if (DependencyIndex && *DependencyIndex != i)
+			{
+				Dependents[*DependencyIndex].Add(i);
+				++NumPendingDependencies[i];
+			}
+		}
+	}
+	
+	TArray<int32> Layer;
+	
+	for (int32 i = 0; i < ScriptAssets.Num(); ++i)
+	{
+		if (NumPendingDependencies[i] == 0)
+		{
+			Layer.Add(i);
+		}
+	}
+	
+	TArray<TArray<FAssetData>> Batches;
+	TArray<bool> Emitted;
+	Emitted.SetNumZeroed(ScriptAssets.Num());
+	int32 NumEmitted = 0;
+	
+	auto EmitLayer = [&] (const TArray<int32>& LayerIndices)
+	{
+		for (int32 Start = 0; Start < LayerIndices.Num(); Start += BatchSize)
+		{
+			TArray<FAssetData>& Batch = Batches.AddDefaulted_GetRef();
+			Batch.Reserve(FMath::Min(BatchSize, LayerIndices.Num() - Start));
+			
+			for (int32 i = Start; i < FMath::Min(Start + BatchSize, LayerIndices.Num()); ++i)
+			{
+				Batch.Add(ScriptAssets[LayerIndices[i]]);
+				Emitted[LayerIndices[i]] = true;
+				++NumEmitted;
+			}
+		}
+	};
+	
+	while (!Layer.IsEmpty())
+	{
+		EmitLayer(Layer);
+		
+		TArray<int32> NextLayer;
+		
+		for (int32 Index : Layer)
+		{
+			for (int32 Dependent : Dependents[Index])
+			{
+				if (--NumPendingDependencies[Dependent] == 0)
+				{
+					NextLayer.Add(Dependent);
+				}
+			}
+		}
+		
+		Layer = MoveTemp(NextLayer);
+	}
+	
+	// Whatever is left is part of a dependency cycle; the compiler copes with those, they just can't be ordered
+	if (NumEmitted < ScriptAssets.Num())
+	{
+		TArray<int32> Remaining;
+		
+		for (int32 i = 0; i < ScriptAssets.Num(); ++i)
+		{
+			if (!Emitted[i])
+			{
+				Remaining.Add(i);
+			}
+		}
+		
+		UE_LOG(LogBangoEditor, Warning, TEXT("%i scripts are part of dependency cycles and will be compiled last"), Remaining.Num());
+		
+		EmitLayer(Remaining);
+	}
+	
+	return Batches;
+}
+
+// ----------------------------------------------
+
+bool UBangoCompileScriptsCommandlet::ResavePackage(UPackage* Package)
+{
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+	
+	if (IFileManager::Get().IsReadOnly(*Filename))
+	{
+		UE_LOG(LogBangoEditor, Warning, TEXT("Skipping resave of read-only package %s (check it out first)"), *Filename);
+		return false;
+	}
+	
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError;
+	
+	if (!UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs))
+	{
+		UE_LOG(LogBangoEditor, Error, TEXT("Failed to resave %s"), *Filename);
+		return false;
+	}
+	
+	return true;
+}
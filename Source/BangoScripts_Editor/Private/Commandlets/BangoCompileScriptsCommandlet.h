@@ -0,0 +1,31 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "BangoCompileScriptsCommandlet.generated.h"
+
+struct FAssetData;
+
+/**
+ * Recompiles every Bango script blueprint found by the asset registry. Scripts are grouped into batches so that a script always compiles after the scripts
+ * it depends on; each batch is loaded through the async loader in one go, compiled, and garbage collected before the next one.
+ * Scripts whose graphs hash the same as at their last successful compile are skipped (and not resaved) unless -Force is passed.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=BangoCompileScripts [-Path=/Game/Scripts,/Game/Other] [-BatchSize=64] [-Resave] [-Force] [-Top=20] -unattended -nullrhi
+ */
+UCLASS()
+class UBangoCompileScriptsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+	
+public:
+	UBangoCompileScriptsCommandlet();
+	
+	int32 Main(const FString& Params) override;
+	
+protected:
+	// Splits the scripts into dependency layers (a script only depends on scripts from earlier layers), then slices each layer into batches
+	static TArray<TArray<FAssetData>> BuildBatches(const TArray<FAssetData>& ScriptAssets, int32 BatchSize);
+	
+	static bool ResavePackage(UPackage* Package);
+};
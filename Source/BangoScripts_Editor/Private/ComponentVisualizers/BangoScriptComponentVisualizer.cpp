@@ -3,7 +3,10 @@
 #include "SceneView.h"
 #include "BangoScripts/Components/BangoScriptComponent.h"
 #include "BangoScripts/Core/BangoScriptBlueprint.h"
+#include "Editor.h"
+#include "Engine/Selection.h"
 #include "Framework/Application/SlateApplication.h"
+#include "GameFramework/Actor.h"
 #include "Utilities/BangoEditorUtility.h"
 
 // ----------------------------------------------
@@ -35,13 +38,39 @@ void FBangoScriptComponentVisualizer::DrawVisualizationHUD(const UActorComponent
 		return;
 	}
 	
-	UBangoScriptBlueprint* Blueprint = ScriptComponent->GetScriptBlueprint();
-	if (!Blueprint)
+	// The engine calls this once per selected script component. All of them are drawn on the first call of each viewport frame, so the view gets a
+	// single batch.
+	if (LastDrawnViewport == Viewport && LastDrawnFrame == GFrameCounter)
 	{
 		return;
 	}
+	
+	LastDrawnViewport = Viewport;
+	LastDrawnFrame = GFrameCounter;
+	
+	TArray<UBangoScriptBlueprint*, TInlineAllocator<8>> Blueprints;
+	Blueprints.Add(ScriptComponent->GetScriptBlueprint());
+	
+	TArray<UBangoScriptComponent*> ActorScriptComponents;
+	
+	for (FSelectionIterator It = GEditor->GetSelectedActorIterator(); It; ++It)
+	{
+		const AActor* Actor = Cast<AActor>(*It);
 		
-	Bango::Editor::DebugDrawActorConnections(*Blueprint, *View, *Canvas);
+		if (!Actor)
+		{
+			continue;
+		}
+		
+		Actor->GetComponents(ActorScriptComponents);
+		
+		for (const UBangoScriptComponent* ActorScriptComponent : ActorScriptComponents)
+		{
+			Blueprints.AddUnique(ActorScriptComponent->GetScriptBlueprint());
+		}
+	}
+	
+	Bango::Editor::DebugDrawActorConnections(Blueprints, *View, *Canvas);
 }
 
 // ----------------------------------------------
@@ -15,4 +15,9 @@ class FBangoScriptComponentVisualizer : public FComponentVisualizer
 	bool GetScreenPos(const FSceneView* View, const FVector& WorldPos, FVector2D& ScreenPos);
 	
 	bool VisProxyHandleClick(FEditorViewportClient* InViewportClient, HComponentVisProxy* VisProxy, const FViewportClick& Click) override;
+	
+	// Viewport and frame the selected scripts' connections were last drawn for
+	const FViewport* LastDrawnViewport = nullptr;
+	
+	uint64 LastDrawnFrame = 0;
 };
@@ -360,6 +360,7 @@ void SGraphNode_BangoFindActor::UpdateCompactNode()
 							return FStyleDefaults::GetNoBrush();
 						}
 						case EHardActorReferenceStatus::SoftReference:
+						case EHardActorReferenceStatus::StreamingHint:
 						{
 							return FBangoEditorStyle::GetImageBrush(BangoEditorBrushes.Icon_SoftPointerIndicator);
 						}
@@ -418,6 +419,10 @@ void SGraphNode_BangoFindActor::UpdateCompactNode()
 							{
 								return LOCTEXT("BangoActorRefNode_SoftRef", "Soft Ref - WARNING: you must ensure actor will be loaded when script runs!");
 							}
+							case EHardActorReferenceStatus::StreamingHint:
+							{
+								return LOCTEXT("BangoActorRefNode_StreamingHint", "Streaming Hint - actor is streamed in right before the script runs");
+							}
 						}
 							
 						return LOCTEXT("BangoActorRefNode_Error", "Error");
@@ -439,6 +444,7 @@ void SGraphNode_BangoFindActor::UpdateCompactNode()
 									return FBangoEditorStyle::GetImageBrush(BangoEditorBrushes.Icon_ActorRefButton_Hard);
 								}
 								case EHardActorReferenceStatus::SoftReference:
+								case EHardActorReferenceStatus::StreamingHint:
 								{
 									return FBangoEditorStyle::GetImageBrush(BangoEditorBrushes.Icon_ActorRefButton_Soft);
 								}
@@ -653,6 +659,10 @@ FSlateColor SGraphNode_BangoFindActor::ColorAndOpacity_SoftIndicator() const
 		{
 			return Bango::Colors::SoftPointerCyan;
 		}
+		case EHardActorReferenceStatus::StreamingHint:
+		{
+			return Bango::Colors::LightGreen_SemiTrans;
+		}
 	}
 	
 	return Bango::Colors::Error;
@@ -679,6 +689,11 @@ SGraphNode_BangoFindActor::EHardActorReferenceStatus SGraphNode_BangoFindActor::
 			{
 				return HardReference;
 			}
+			
+			if (Interface->GetScriptContainer().HasStreamingHint(GetTargetActorSoft()))
+			{
+				return StreamingHint;
+			}
 		}
 	}
 	
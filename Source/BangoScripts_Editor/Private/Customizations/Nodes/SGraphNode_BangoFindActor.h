@@ -13,6 +13,7 @@ class SGraphNode_BangoFindActor : public SGraphNodeK2Base
 		Unknown,
 		HardReference,
 		SoftReference,
+		StreamingHint,
 	};
 	
 public:
@@ -198,6 +198,9 @@ void FBangoScriptContainerCustomization::CustomizeChildren(TSharedRef<IPropertyH
 	
 	TSharedPtr<IPropertyHandle> HardReferencedActors = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FBangoScriptContainer, HardActorRefs));
 	ChildBuilder.AddProperty(HardReferencedActors.ToSharedRef());
+	
+	TSharedPtr<IPropertyHandle> StreamingHintActors = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FBangoScriptContainer, StreamingHintActorRefs));
+	ChildBuilder.AddProperty(StreamingHintActors.ToSharedRef());
 }
 
 // ----------------------------------------------
@@ -13,9 +13,12 @@
 #include "BangoScripts/EditorTooling/BangoColors.h"
 #include "BangoScripts/EditorTooling/BangoDebugDrawCanvas.h"
 #include "BangoScripts/EditorTooling/BangoDebugUtility.h"
+#include "BangoScripts/EditorTooling/BangoDevSettings.h"
 #include "BangoScripts/EditorTooling/BangoEditorDelegates.h"
 #include "BangoScripts/EditorTooling/BangoScriptsEditorLog.h"
+#include "BangoScripts/Subsystem/BangoComponentIndexSubsystem.h"
 #include "BangoScripts_EditorTooling/BangoScripts_EditorTooling.h"
+#include "Components/BillboardComponent.h"
 #include "Components/Viewport.h"
 #include "Debug/DebugDrawService.h"
 #include "Engine/GameViewportClient.h"
@@ -28,6 +31,19 @@
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
+namespace Bango::ScriptHover
+{
+	// Screen distances from the mouse to a billboard that start a hover, or keep the focused one hovered
+	constexpr float UnfocusedRadius = 25.0f;
+	constexpr float FocusedRadius = 30.0f;
+	
+	// Cell of UBangoScriptsDebugDrawService::HoverGrid. Anything within FocusedRadius of a point is in that point's cell or one of its neighbours.
+	FIntPoint GetCell(const FVector2f& ScreenPos)
+	{
+		return FIntPoint(FMath::FloorToInt32(ScreenPos.X / FocusedRadius), FMath::FloorToInt32(ScreenPos.Y / FocusedRadius));
+	}
+}
+
 // ================================================================================================
 
 FBangoScriptOctreeElement::FBangoScriptOctreeElement(UBangoScriptComponent* InScriptComponent)
@@ -60,6 +76,35 @@ void FBangoScriptOctreeSemantics::SetElementId(const FBangoScriptOctreeElement&
 
 // ================================================================================================
 
+FConvexVolume FBangoScripts_NearbyScriptsView::MakeCullingFrustum() const
+{
+	FConvexVolume CullingFrustum;
+	
+	if (PlayerController)
+	{
+		AActor* ViewTarget = PlayerController->PlayerCameraManager->GetViewTarget();
+		
+		FMatrix ViewMatrix;
+		FMatrix ProjectionMatrix;
+		FMatrix ViewProjectionMatrix;
+		UGameplayStatics::CalculateViewProjectionMatricesFromViewTarget(ViewTarget, ViewMatrix, ProjectionMatrix, ViewProjectionMatrix);
+		
+		GetViewFrustumBounds(CullingFrustum, ViewProjectionMatrix, true, true);
+	}
+	else if (EditorViewportClient)
+	{
+		FSceneViewFamilyContext ViewFamily(FSceneViewFamily::ConstructionValues(Viewport, EditorViewportClient->GetScene(), EditorViewportClient->EngineShowFlags));
+
+		FSceneView* SceneView = EditorViewportClient->CalcSceneView(&ViewFamily);
+		
+		CullingFrustum = SceneView->GetCullingFrustum();
+	}
+	
+	return CullingFrustum;
+}
+
+// ================================================================================================
+
 bool FBangoDebugDraw_ScriptComponentHover::TryToFocusOnComponent(const UBangoScriptComponent* Contender, float MouseDistanceToBillboard)
 {
 	// Always succeed if we're the only contender
@@ -139,6 +184,13 @@ bool FBangoDebugDraw_ScriptComponentHover::IsHoveredOrHoverPendingFor(UBangoScri
 
 // ----------------------------------------------
 
+bool FBangoDebugDraw_ScriptComponentHover::IsHoverPending() const
+{
+	return FocusedComponent.IsValid() && !bHoverConsumed;
+}
+
+// ----------------------------------------------
+
 bool FBangoDebugDraw_ScriptComponentHover::HasFocusedComponent() const
 {
 	return FocusedComponent.IsValid();
@@ -198,6 +250,8 @@ void UBangoScriptsDebugDrawService::Initialize(FSubsystemCollectionBase& Collect
 	FBangoEditorDelegates::ScriptComponentRegistered.AddUObject(this, &ThisClass::OnBangoScriptRegistrationChange);
 	
 	GEngine->OnActorMoved().AddUObject(this, &ThisClass::OnGlobalActorMoved);
+	
+	BillboardClusterViewExtension = FSceneViewExtensions::NewExtension<FBangoScripts_BillboardClusterViewExtension>(this);
 }
 
 // ----------------------------------------------
@@ -210,6 +264,9 @@ void UBangoScriptsDebugDrawService::Deinitialize()
 	// TODO this should not be needed! I should be able to subscribe to TransformUpdated of the actor's root component, but I can't. See header for more notes.
 	GEngine->OnActorMoved().RemoveAll(this);
 	
+	ReleaseSuppressedBillboards();
+	BillboardClusterViewExtension.Reset();
+	
 	Super::Deinitialize();
 }
 
@@ -224,27 +281,41 @@ bool UBangoScriptsDebugDrawService::IsTickable() const
 
 void UBangoScriptsDebugDrawService::DebugDraw(UCanvas* Canvas, APlayerController* ALWAYSNULL_DONOTUSE)
 {
-	if (GEditor->IsPlaySessionInProgress())
+	UpdateNearbyScripts();
+	
+	// Only the viewport the scripts were gathered for
+	if (!Canvas || !Canvas->Canvas || !Canvas->SceneView || !NearbyScriptsViewport || Canvas->Canvas->GetRenderTarget() != NearbyScriptsViewport)
+	{
+		return;
+	}
+	
+	ProjectNearbyScripts(*Canvas->SceneView);
+	
+	const bool bPIE = GEditor->IsPlaySessionInProgress();
+	
+	UpdateSuppressedBillboards(bPIE);
+	
+	if (bPIE)
 	{
-		UpdateNearbyScripts();
-		
 		for (FBangoScripts_NearbyScript& NearbyScript : NearbyScripts)
 		{
-			const UBangoScriptComponent* ScriptComponent = NearbyScript.Component;
+			const UBangoScriptComponent* ScriptComponent = NearbyScript.Component.Get();
 			
-			DrawPIEIcon(Canvas, ScriptComponent, NearbyScript.ScreenPos);
+			if (ScriptComponent && NearbyScript.bOnScreen && NearbyScript.bDetailed)
+			{
+				DrawPIEIcon(Canvas, ScriptComponent, NearbyScript.ScreenPos);
+			}
 		}
 	}
+	
+	DrawIconClusters(Canvas, bPIE);
 }
 
 // ----------------------------------------------
 
 void UBangoScriptsDebugDrawService::Tick(float DeltaTime)
 {	
-	if (!GEditor->IsPlaySessionInProgress())
-	{
-		UpdateNearbyScripts();
-	}
+	UpdateNearbyScripts();
 	
 	FViewport* Viewport = GEditor->GetActiveViewport();
 	
@@ -258,21 +329,68 @@ void UBangoScriptsDebugDrawService::Tick(float DeltaTime)
 	
 	if (!FBangoScripts_EditorToolingModule::BangoScriptsShowFlag.IsEnabled(*ShowFlags))
 	{
-		NearbyScripts.Empty();
+		ClearNearbyScripts();
+		ReleaseSuppressedBillboards();
+		return;
+	}
+	
+	// The mouse is elsewhere, nothing in the viewport can be hovered. The popup keeps focus for as long as it's hovered.
+	if (!bMouseInNearbyScriptsView)
+	{
+		if (HoverInfo.HasFocusedComponent() && !HoverInfo.IsWidgetVisibleAndHovered())
+		{
+			HoverInfo.Reset();
+		}
+		
+		return;
+	}
+	
+	// Nothing moved and no hover is waiting on its delay, so the last result still stands. The popup keeps focus for as long as it's hovered.
+	const bool bMouseMoved = MouseScreenPos != LastHoverMouseScreenPos;
+	const bool bProjectionChanged = ProjectionRevision != LastHoverProjectionRevision;
+	
+	if ((!bMouseMoved && !bProjectionChanged && !HoverInfo.IsHoverPending()) || HoverInfo.IsWidgetVisibleAndHovered())
+	{
 		return;
 	}
 	
+	LastHoverMouseScreenPos = MouseScreenPos;
+	LastHoverProjectionRevision = ProjectionRevision;
+	
 	bool bFoundAnyHover = false;
+	bool bPIE = GEditor->IsPlaySessionInProgress();
 	
-	for (FBangoScripts_NearbyScript& NearbyScript : NearbyScripts)
+	// Far scripts aren't in the grid, they don't get hover controls
+	const FIntPoint MouseCell = Bango::ScriptHover::GetCell(MouseScreenPos);
+	
+	for (int32 CellY = MouseCell.Y - 1; CellY <= MouseCell.Y + 1; ++CellY)
 	{
-		UBangoScriptComponent* ScriptComponent = NearbyScript.Component;
-		
-		//DrawDebugSphere(ScriptComponent->GetWorld(), ScriptComponent->GetBillboardPosition(), 25.0f, 12, FColor::Cyan, false);
-		
-		bool bPIE = GEditor->IsPlaySessionInProgress();
-		
-		bFoundAnyHover |= DrawViewportHoverControls(ScriptComponent, NearbyScript.MouseDistSqrd, NearbyScript.ScreenPos, bPIE);
+		for (int32 CellX = MouseCell.X - 1; CellX <= MouseCell.X + 1; ++CellX)
+		{
+			const TArray<int32, TInlineAllocator<4>>* Cell = HoverGrid.Find(FIntPoint(CellX, CellY));
+			
+			if (!Cell)
+			{
+				continue;
+			}
+			
+			for (int32 ScriptIndex : *Cell)
+			{
+				FBangoScripts_NearbyScript& NearbyScript = NearbyScripts[ScriptIndex];
+				UBangoScriptComponent* ScriptComponent = NearbyScript.Component.Get();
+				
+				if (!ScriptComponent)
+				{
+					continue;
+				}
+				
+				//DrawDebugSphere(ScriptComponent->GetWorld(), ScriptComponent->GetBillboardPosition(), 25.0f, 12, FColor::Cyan, false);
+				
+				const float MouseDistSqrd = FVector2f::DistSquared(NearbyScript.ScreenPos, MouseScreenPos);
+				
+				bFoundAnyHover |= DrawViewportHoverControls(ScriptComponent, MouseDistSqrd, NearbyScript.ScreenPos, bPIE);
+			}
+		}
 	}
 	
 	if (!bFoundAnyHover)
@@ -294,8 +412,116 @@ void UBangoScriptsDebugDrawService::UpdateNearbyScripts()
 	
 	LastUpdateFrame = GFrameCounter;
 	
-	NearbyScripts.Empty();
+	FlushMovedActors();
+	
+	FBangoScripts_NearbyScriptsView View;
+	
+	if (!GetNearbyScriptsView(View))
+	{
+		// No viewport to draw cluster badges in, every billboard has to show again
+		ClearNearbyScripts();
+		ReleaseSuppressedBillboards();
+		NearbyScriptsViewport = nullptr;
+		bMouseInNearbyScriptsView = false;
+		return;
+	}
+	
+	bMouseInNearbyScriptsView = View.bMouseInViewport;
+	
+	if (bMouseInNearbyScriptsView)
+	{
+		MouseScreenPos = View.MouseScreenPos;
+	}
+	
+	// Suppression belongs to the viewport it was projected for, the new one works out its own when it draws
+	if (View.Viewport != SuppressedBillboardsViewport)
+	{
+		ReleaseSuppressedBillboards();
+	}
+	
+	const float MoveThreshold = UBangoScriptsDeveloperSettings::GetNearbyScriptCameraMoveThreshold();
+	const float RotateThreshold = UBangoScriptsDeveloperSettings::GetNearbyScriptCameraRotateThreshold();
+	const double MaxQueryAge = UBangoScriptsDeveloperSettings::GetNearbyScriptMaxQueryAge();
+	
+	const double Now = FPlatformTime::Seconds();
+	const double QueryAge = Now - LastQueryTime;
+	
+	const bool bViewChanged = LastQueryTime < 0.0 || View.Viewport != NearbyScriptsViewport || View.World != NearbyScriptsWorld.Get();
+	const bool bCameraMoved = FVector::DistSquared(View.CameraLocation, LastQueryCameraLocation) > FMath::Square(MoveThreshold) || !View.CameraRotation.Equals(LastQueryCameraRotation, RotateThreshold);
+	const bool bTreeChanged = OctreeRevision != LastQueryOctreeRevision;
+	
+	if (!bViewChanged && QueryAge < MaxQueryAge && (!(bCameraMoved || bTreeChanged) || QueryAge < UBangoScriptsDeveloperSettings::GetNearbyScriptUpdateInterval()))
+	{
+		return;
+	}
 	
+	NearbyScriptsViewport = View.Viewport;
+	NearbyScriptsWorld = View.World;
+	LastQueryCameraLocation = View.CameraLocation;
+	LastQueryCameraRotation = View.CameraRotation;
+	LastQueryOctreeRevision = OctreeRevision;
+	LastQueryTime = Now;
+	
+	TArray<FBangoScripts_NearbyScript> PreviousScripts = MoveTemp(NearbyScripts);
+	
+	ClearNearbyScripts();
+	
+	const FConvexVolume CullingFrustum = View.MakeCullingFrustum();
+	const bool bPIE = View.PlayerController != nullptr;
+	
+	auto FrustumTest = [this, &CullingFrustum, bPIE](const FBangoScriptOctreeElement& ScriptElement)
+	{
+		if (ScriptElement.ScriptComponent.IsStale())
+		{
+			return;
+		}
+		
+		if (!ScriptElement.ScriptComponent->IsBillboardEnabled())
+		{
+			return;
+		}
+		
+		if (bPIE && !ScriptElement.ScriptComponent->HasValidScript())
+		{
+			return;
+		}
+		
+		if (ScriptElement.ScriptComponent.IsValid() && CullingFrustum.IntersectPoint(ScriptElement.Position))
+		{
+			NearbyScripts.Emplace(ScriptElement.ScriptComponent.Get(), ScriptElement.Position);
+		}
+	};
+	
+	FBoxCenterAndExtent CameraBox(View.CameraLocation, FVector(UBangoScriptsDeveloperSettings::GetNearbyScriptQueryExtent()));
+
+	ScriptComponentTree.FindElementsWithBoundsTest(CameraBox, FrustumTest);
+	
+	// Screen positions only come from drawing. Keep the previous ones until the next draw, so hover doesn't drop out in between.
+	TMap<UBangoScriptComponent*, const FBangoScripts_NearbyScript*> PreviousByComponent;
+	PreviousByComponent.Reserve(PreviousScripts.Num());
+	
+	for (const FBangoScripts_NearbyScript& PreviousScript : PreviousScripts)
+	{
+		PreviousByComponent.Add(PreviousScript.Component.Get(), &PreviousScript);
+	}
+	
+	for (FBangoScripts_NearbyScript& NearbyScript : NearbyScripts)
+	{
+		if (const FBangoScripts_NearbyScript* const* PreviousScript = PreviousByComponent.Find(NearbyScript.Component.Get()))
+		{
+			NearbyScript.ScreenPos = (*PreviousScript)->ScreenPos;
+			NearbyScript.bOnScreen = (*PreviousScript)->bOnScreen;
+			NearbyScript.bDetailed = (*PreviousScript)->bDetailed;
+		}
+	}
+	
+	RebuildHoverGrid();
+}
+
+// ----------------------------------------------
+
+bool UBangoScriptsDebugDrawService::GetNearbyScriptsView(FBangoScripts_NearbyScriptsView& OutView) const
+{
 	// TODO return if the camera is moving or other input is going on
 
 	if (GEditor->IsPlaySessionInProgress() && !GEditor->IsSimulateInEditorInProgress())
@@ -304,39 +530,28 @@ void UBangoScriptsDebugDrawService::UpdateNearbyScripts()
 		
 		if (!World)
 		{
-			return;
+			return false;
 		}
 		
 		UGameViewportClient* GameViewportClient = GEditor->GameViewport;
 	
 		if (!GameViewportClient)
 		{
-			return;
+			return false;
 		}
 		
 		TSharedPtr<SViewport> ViewportWidget = GameViewportClient->GetGameViewportWidget();
 		
 		if (!ViewportWidget.IsValid())
 		{
-			return;
+			return false;
 		}
 
 		if (ViewportWidget->HasAnyUserFocus())
 		{
-			return;
+			return false;
 		}
 		
-		FVector2D GlobalMousePos = FSlateApplication::Get().GetCursorPos();
-		
-		// Check if mouse is within viewport
-		const FVector2D AbsoluteMousePos = FSlateApplication::Get().GetCursorPos();
-		if (!GameViewportClient->GetGameViewportWidget()->GetCachedGeometry().IsUnderLocation(AbsoluteMousePos))
-		{
-			return;
-		}
-	
-		FVector2f MouseScreenPos = GlobalMousePos - ViewportWidget->GetCachedGeometry().GetAbsolutePosition();
-		
 		APlayerController* PlayerController = nullptr;
 		
 		for (APlayerController* Actor : TActorRange<APlayerController>(World))
@@ -345,154 +560,242 @@ void UBangoScriptsDebugDrawService::UpdateNearbyScripts()
 			break;
 		}
 		
-		if (!PlayerController)
+		if (!PlayerController || !PlayerController->PlayerCameraManager)
 		{
-			return;
+			return false;
 		}
 		
-		AActor* ViewTarget = PlayerController->PlayerCameraManager->GetViewTarget();
-		
-		FMatrix One;
-		FMatrix Two;
-		FMatrix Three;
-		UGameplayStatics::CalculateViewProjectionMatricesFromViewTarget(ViewTarget, One, Two, Three);
-		
-		FConvexVolume CullingFrustum;
-		GetViewFrustumBounds(CullingFrustum, Three, true, true);
+		OutView.Viewport = GameViewportClient->Viewport;
+		OutView.World = World;
+		OutView.PlayerController = PlayerController;
+		OutView.CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+		OutView.CameraRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
 		
-		auto FrustumTest = [this, CullingFrustum, PlayerController, MouseScreenPos](const FBangoScriptOctreeElement& ScriptElement)
-		{
-			if (ScriptElement.ScriptComponent.IsStale())
-			{
-				return;
-			}
-			
-			if (!ScriptElement.ScriptComponent->IsBillboardEnabled())
-			{
-				return;
-			}
-			
-			if (ScriptElement.ScriptComponent.IsValid() && CullingFrustum.IntersectPoint(ScriptElement.Position) && ScriptElement.ScriptComponent->HasValidScript())
-			{
-				FVector2D ScriptScreenPos;
-				
-				if (PlayerController->ProjectWorldLocationToScreen(ScriptElement.Position, ScriptScreenPos))
-				{
-					float DistSqrd = FVector2f::DistSquared(FVector2f(ScriptScreenPos), MouseScreenPos);
-			
-					FBangoScripts_NearbyScript NearbyScript(ScriptElement.ScriptComponent.Get(), DistSqrd, FVector2f(ScriptScreenPos));
-			
-					NearbyScripts.Emplace(NearbyScript);	
-				}
-			}
-		};
+		const FVector2D AbsoluteMousePos = FSlateApplication::Get().GetCursorPos();
+		OutView.bMouseInViewport = ViewportWidget->GetCachedGeometry().IsUnderLocation(AbsoluteMousePos);
+		OutView.MouseScreenPos = AbsoluteMousePos - ViewportWidget->GetCachedGeometry().GetAbsolutePosition();
 		
-		FVector CameraPos = PlayerController->PlayerCameraManager->GetCameraLocation();
+		return true;
+	}
 	
-		FBoxCenterAndExtent CameraBox(CameraPos, FVector(5000.0f));
+	FLevelEditorModule& LevelEditorModule = FModuleManager::LoadModuleChecked<FLevelEditorModule>("LevelEditor");
 
-		ScriptComponentTree.FindElementsWithBoundsTest(CameraBox, FrustumTest);
+	TSharedPtr<ILevelEditor> LevelEditor = LevelEditorModule.GetFirstLevelEditor();
+	if (!LevelEditor)
+	{
+		return false;
 	}
-	else
+	
+	TSharedPtr<SLevelViewport> LevelViewport = LevelEditor->GetActiveViewportInterface();
+	if (!LevelViewport.IsValid())
+	{
+		return false;
+	}
+	
+	TSharedPtr<FSceneViewport> SceneViewport = LevelViewport->GetSharedActiveViewport();
+	
+	if (!SceneViewport)
+	{
+		return false;
+	}
+	
+	FViewport* Viewport = SceneViewport->GetViewport();
+	
+	if (!Viewport)
+	{
+		return false;
+	}
+	
+	FViewportClient* ViewportClient = Viewport->GetClient();
+	
+	if (!ViewportClient || !FBangoScripts_EditorToolingModule::BangoScriptsShowFlag.IsEnabled(*ViewportClient->GetEngineShowFlags()))
+	{
+		return false;
+	}
+	
+	UWorld* World = ViewportClient->GetWorld();
+	
+	if (!World)
+	{
+		return false;
+	}
+	
+	TSharedPtr<SViewport> ViewportWidget = SceneViewport->GetViewportWidget().Pin();
+	
+	if (!ViewportWidget.IsValid())
 	{
-		FLevelEditorModule& LevelEditorModule = FModuleManager::LoadModuleChecked<FLevelEditorModule>("LevelEditor");
+		return false;
+	}
+	
+	FLevelEditorViewportClient& EditorViewportClient = LevelViewport->GetLevelViewportClient();
+	
+	OutView.Viewport = Viewport;
+	OutView.World = World;
+	OutView.EditorViewportClient = &EditorViewportClient;
+	OutView.CameraLocation = EditorViewportClient.GetViewLocation();
+	OutView.CameraRotation = EditorViewportClient.GetViewRotation();
+	
+	const FVector2D AbsoluteMousePos = FSlateApplication::Get().GetCursorPos();
+	OutView.bMouseInViewport = ViewportWidget->GetCachedGeometry().IsUnderLocation(AbsoluteMousePos);
+	OutView.MouseScreenPos = AbsoluteMousePos - ViewportWidget->GetCachedGeometry().GetAbsolutePosition();
+	
+	return true;
+}
 
-		TSharedPtr<ILevelEditor> LevelEditor = LevelEditorModule.GetFirstLevelEditor();
-		if (!LevelEditor)
+// ----------------------------------------------
+
+void UBangoScriptsDebugDrawService::ProjectNearbyScripts(const FSceneView& View)
+{
+	IconClusters.Reset();
+	
+	const FVector ViewOrigin = View.ViewMatrices.GetViewOrigin();
+	const double DetailDistSqrd = FMath::Square(UBangoScriptsDeveloperSettings::GetScriptIconDetailDistance());
+	const float ClusterSize = UBangoScriptsDeveloperSettings::GetScriptIconClusterSize();
+	
+	TMap<FIntPoint, int32> ClustersByCell;
+	
+	bool bChanged = false;
+	
+	for (int32 i = 0; i < NearbyScripts.Num(); ++i)
+	{
+		FBangoScripts_NearbyScript& NearbyScript = NearbyScripts[i];
+		
+		const FVector2f OldScreenPos = NearbyScript.ScreenPos;
+		const bool bWasOnScreen = NearbyScript.bOnScreen;
+		const bool bWasDetailed = NearbyScript.bDetailed;
+		
+		const FVector4 ScreenPoint = View.WorldToScreen(NearbyScript.WorldPos);
+		
+		FVector2D PixelLocation;
+		NearbyScript.bOnScreen = ScreenPoint.W > 0.0f && View.ScreenToPixel(ScreenPoint, PixelLocation);
+		NearbyScript.bDetailed = false;
+		NearbyScript.IconCluster = INDEX_NONE;
+		
+		if (!NearbyScript.bOnScreen)
 		{
-			return;
+			bChanged |= bWasOnScreen;
+			continue;
 		}
 		
-		TSharedPtr<SLevelViewport> LevelViewport = LevelEditor->GetActiveViewportInterface();
-		if (!LevelViewport.IsValid())
+		NearbyScript.ScreenPos = FVector2f(PixelLocation);
+		NearbyScript.bDetailed = FVector::DistSquared(ViewOrigin, NearbyScript.WorldPos) <= DetailDistSqrd;
+		
+		bChanged |= !bWasOnScreen || bWasDetailed != NearbyScript.bDetailed || OldScreenPos != NearbyScript.ScreenPos;
+		
+		if (NearbyScript.bDetailed)
 		{
-			return;
+			continue;
 		}
 		
-		TSharedPtr<FSceneViewport> SceneViewport = LevelViewport->GetSharedActiveViewport();
+		const FIntPoint Cell(FMath::FloorToInt32(NearbyScript.ScreenPos.X / ClusterSize), FMath::FloorToInt32(NearbyScript.ScreenPos.Y / ClusterSize));
+		
+		int32& ClusterIndex = ClustersByCell.FindOrAdd(Cell, INDEX_NONE);
 		
-		if (SceneViewport)
+		if (ClusterIndex == INDEX_NONE)
 		{
-			FViewport* Viewport = SceneViewport->GetViewport();
-			
-			if (!Viewport)
-			{
-				return;
-			}
-			
-			FViewportClient* ViewportClient = Viewport->GetClient();
-			
-			if (!ViewportClient || !FBangoScripts_EditorToolingModule::BangoScriptsShowFlag.IsEnabled(*ViewportClient->GetEngineShowFlags()))
-			{
-				return;
-			}
-			
-			UWorld* World = ViewportClient->GetWorld();
-			
-			if (!World)
-			{
-				return;
-			}
-			
-			TWeakPtr<SViewport> ViewportWidget = SceneViewport->GetViewportWidget();
-			
-			if (!ViewportWidget.IsValid())
-			{
-				return;
-			}
-			
-			const FVector2D AbsoluteMousePos = FSlateApplication::Get().GetCursorPos();
-			if (!ViewportWidget.Pin()->GetCachedGeometry().IsUnderLocation(AbsoluteMousePos))
-			{
-				return;
-			}
-			
-			FLevelEditorViewportClient& EditorViewportClient = LevelViewport->GetLevelViewportClient();
+			ClusterIndex = IconClusters.AddDefaulted();
+			IconClusters[ClusterIndex].FirstScript = i;
+		}
+		
+		FBangoScripts_ScriptIconCluster& Cluster = IconClusters[ClusterIndex];
+		Cluster.ScreenSum += NearbyScript.ScreenPos;
+		++Cluster.Count;
+		
+		NearbyScript.IconCluster = ClusterIndex;
+	}
+	
+	// A still camera projects to the same place every frame, nothing to rebuild
+	if (bChanged)
+	{
+		RebuildHoverGrid();
+	}
+}
 
-			FSceneViewFamilyContext ViewFamily(FSceneViewFamily::ConstructionValues(Viewport, EditorViewportClient.GetScene(), EditorViewportClient.EngineShowFlags));
+// ----------------------------------------------
 
-			FSceneView* SceneView = EditorViewportClient.CalcSceneView(&ViewFamily);
-			
-			FConvexVolume CullingFrustum = SceneView->GetCullingFrustum();
-			
-			FVector2f MouseScreenPos = AbsoluteMousePos - ViewportWidget.Pin()->GetCachedGeometry().GetAbsolutePosition();
-			
-			auto FrustumTest = [this, CullingFrustum, SceneView, MouseScreenPos](const FBangoScriptOctreeElement& ScriptElement)
-			{
-				if (ScriptElement.ScriptComponent.IsStale())
-				{
-					return;
-				}
-				
-				if (!ScriptElement.ScriptComponent->IsBillboardEnabled())
-				{
-					return;
-				}
-			
-				if (ScriptElement.ScriptComponent.IsValid() && CullingFrustum.IntersectPoint(ScriptElement.Position) /*&& ScriptElement.ScriptComponent->HasValidScript()*/)
-				{
-					FVector2D PixelLocation;
-					SceneView->WorldToPixel(ScriptElement.Position, PixelLocation);
+void UBangoScriptsDebugDrawService::ClearNearbyScripts()
+{
+	// Runs every frame while there's no view, only bump the revision when there was something to drop
+	if (NearbyScripts.IsEmpty() && IconClusters.IsEmpty() && HoverGrid.IsEmpty())
+	{
+		return;
+	}
+	
+	NearbyScripts.Reset();
+	IconClusters.Reset();
+	HoverGrid.Reset();
+	
+	++ProjectionRevision;
+}
 
-					float DistSqrd = FVector2f::DistSquared(FVector2f(PixelLocation), MouseScreenPos);
-			
-					FBangoScripts_NearbyScript NearbyScript(ScriptElement.ScriptComponent.Get(), DistSqrd, FVector2f(PixelLocation));
-			
-					NearbyScripts.Emplace(NearbyScript);
-				}
-			};
+// ----------------------------------------------
 
-			FVector CameraPos = SceneView->ViewMatrices.GetViewOrigin();
-			
-			FBoxCenterAndExtent CameraBox(CameraPos, FVector(5000.0f));
+void UBangoScriptsDebugDrawService::RebuildHoverGrid()
+{
+	HoverGrid.Reset();
+	
+	for (int32 i = 0; i < NearbyScripts.Num(); ++i)
+	{
+		if (NearbyScripts[i].bOnScreen && NearbyScripts[i].bDetailed)
+		{
+			HoverGrid.FindOrAdd(Bango::ScriptHover::GetCell(NearbyScripts[i].ScreenPos)).Add(i);
+		}
+	}
+	
+	++ProjectionRevision;
+}
 
-			ScriptComponentTree.FindElementsWithBoundsTest(CameraBox, FrustumTest);
+// ----------------------------------------------
+
+void UBangoScriptsDebugDrawService::UpdateSuppressedBillboards(bool bPIE)
+{
+	// The engine doesn't draw editor billboards in PIE, the icons are all ours
+	if (bPIE)
+	{
+		ReleaseSuppressedBillboards();
+		return;
+	}
+	
+	// Clusters only change along with the projection
+	if (SuppressionProjectionRevision == ProjectionRevision && SuppressedBillboardsViewport == NearbyScriptsViewport)
+	{
+		return;
+	}
+	
+	SuppressionProjectionRevision = ProjectionRevision;
+	SuppressedBillboardsViewport = NearbyScriptsViewport;
+	SuppressedBillboards.Reset();
+	
+	for (int32 i = 0; i < NearbyScripts.Num(); ++i)
+	{
+		const FBangoScripts_NearbyScript& NearbyScript = NearbyScripts[i];
+		const UBangoScriptComponent* ScriptComponent = NearbyScript.Component.Get();
+		
+		if (NearbyScript.IconCluster == INDEX_NONE || !ScriptComponent || !ScriptComponent->GetBillboard())
+		{
+			continue;
+		}
+		
+		const FBangoScripts_ScriptIconCluster& Cluster = IconClusters[NearbyScript.IconCluster];
+		
+		if (Cluster.Count > 1 && Cluster.FirstScript != i)
+		{
+			SuppressedBillboards.Add(ScriptComponent->GetBillboard()->GetPrimitiveSceneId());
 		}
 	}
 }
 
 // ----------------------------------------------
 
+void UBangoScriptsDebugDrawService::ReleaseSuppressedBillboards()
+{
+	SuppressedBillboards.Reset();
+	SuppressedBillboardsViewport = nullptr;
+	SuppressionProjectionRevision.Reset();
+}
+
+// ----------------------------------------------
+
 TStatId UBangoScriptsDebugDrawService::GetStatId() const
 {
 	return TStatId();
@@ -538,12 +841,9 @@ void UBangoScriptsDebugDrawService::OnScriptComponentMoved(USceneComponent* Scen
 {
 	if (ScriptComponent.Pin())
 	{
-		FBangoScriptOctreeElement Element(ScriptComponent.Get());
-	
-		// DrawDebugSphere(Element.ScriptComponent->GetWorld(), SceneComponent->GetComponentLocation(), 30.0f, 12, FColor::Yellow, false, 1.0f);
+		// DrawDebugSphere(ScriptComponent->GetWorld(), SceneComponent->GetComponentLocation(), 30.0f, 12, FColor::Yellow, false, 1.0f);
 		
-		RemoveElement(Element);
-		AddElement(Element);
+		PendingMovedActors.Add(ScriptComponent->GetOwner());
 	}
 }
 
@@ -552,6 +852,7 @@ void UBangoScriptsDebugDrawService::OnScriptComponentMoved(USceneComponent* Scen
 void UBangoScriptsDebugDrawService::AddElement(FBangoScriptOctreeElement& Element)
 {
 	ScriptComponentTree.AddElement(Element);
+	++OctreeRevision;
     
 	// DrawDebugSphere(Element.ScriptComponent->GetWorld(), Element.Position, 50.0f, 12, FColor::Green, false, 5.0f);
 }
@@ -562,7 +863,11 @@ void UBangoScriptsDebugDrawService::RemoveElement(FBangoScriptOctreeElement& Ele
 {
 	if (Element.ScriptComponent->DebugElementId.IsValidId())
 	{
-		ScriptComponentTree.RemoveElement(Element.ScriptComponent.GetEvenIfUnreachable()->DebugElementId);
+		UBangoScriptComponent* ScriptComponent = Element.ScriptComponent.GetEvenIfUnreachable();
+		
+		ScriptComponentTree.RemoveElement(ScriptComponent->DebugElementId);
+		ScriptComponent->DebugElementId = FOctreeElementId2();
+		++OctreeRevision;
 
 		// DrawDebugSphere(Element.ScriptComponent->GetWorld(), Element.Position, 40.0f, 12, FColor::Red, false, 5.0f);
 	}
@@ -572,19 +877,57 @@ void UBangoScriptsDebugDrawService::RemoveElement(FBangoScriptOctreeElement& Ele
 
 void UBangoScriptsDebugDrawService::OnGlobalActorMoved(AActor* Actor)
 {
+	// Dragging fires this for every selected actor on every mouse move, the octree is only updated once per actor per frame
 	if (ScriptOwners.Contains(Actor))
 	{
-		TArray<UBangoScriptComponent*> ActorScriptComponents;
-		Actor->GetComponents<UBangoScriptComponent>(ActorScriptComponents);
+		PendingMovedActors.Add(Actor);
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoScriptsDebugDrawService::FlushMovedActors()
+{
+	for (const TWeakObjectPtr<AActor>& WeakActor : PendingMovedActors)
+	{
+		AActor* Actor = WeakActor.Get();
 		
-		for (UBangoScriptComponent* ScriptComponent : ActorScriptComponents)
+		if (!Actor || !ScriptOwners.Contains(Actor))
 		{
-			FBangoScriptOctreeElement Element(ScriptComponent);
-			
-			RemoveElement(Element);
-			AddElement(Element);
+			continue;
 		}
+		
+		UBangoComponentIndexSubsystem::ForEachScriptComponent(Actor, [this] (UBangoScriptComponent* ScriptComponent)
+		{
+			UpdateElement(ScriptComponent);
+		});
 	}
+	
+	PendingMovedActors.Reset();
+}
+
+// ----------------------------------------------
+
+void UBangoScriptsDebugDrawService::UpdateElement(UBangoScriptComponent* ScriptComponent)
+{
+	const FOctreeElementId2 ElementId = ScriptComponent->DebugElementId;
+	
+	// Not in the tree, registration will add it
+	if (!ElementId.IsValidId() || !ScriptComponentTree.IsValidElementId(ElementId))
+	{
+		return;
+	}
+	
+	FBangoScriptOctreeElement Element(ScriptComponent);
+	
+	// Rotating or otherwise touching an actor doesn't always move its billboard
+	if (ScriptComponentTree.GetElementById(ElementId).Position.Equals(Element.Position))
+	{
+		return;
+	}
+	
+	RemoveElement(Element);
+	AddElement(Element);
 }
 
 // ----------------------------------------------
@@ -651,8 +994,8 @@ bool UBangoScriptsDebugDrawService::DrawViewportHoverControls(UBangoScriptCompon
 	}
 	
 	// TODO turn these into dev settings
-	const float UnfocusedThreshold = 625.0f; // Squared screen distance (25 pixels)
-	const float FocusedThreshold = 900.0f; // Squared screen distance (30 pixels)
+	const float UnfocusedThreshold = FMath::Square(Bango::ScriptHover::UnfocusedRadius);
+	const float FocusedThreshold = FMath::Square(Bango::ScriptHover::FocusedRadius);
 	const float MouseThreshold = (HoverInfo.GetFocusedComponent() == ScriptComponent) ? FocusedThreshold : UnfocusedThreshold;
 	
 	// Don't try to display popup if the mouse is nowhere near the component; only evaluate this if we don't already have a popup
@@ -810,6 +1153,36 @@ void UBangoScriptsDebugDrawService::DrawPIEIcon(UCanvas* Canvas, const UBangoScr
 	}
 }
 
+// ----------------------------------------------
+
+void UBangoScriptsDebugDrawService::DrawIconClusters(UCanvas* Canvas, bool bPIE)
+{
+	for (const FBangoScripts_ScriptIconCluster& Cluster : IconClusters)
+	{
+		const UBangoScriptComponent* FirstComponent = NearbyScripts[Cluster.FirstScript].Component.Get();
+		
+		// Lone far scripts are drawn like any other, there's nothing to merge. Outside of PIE the engine draws their billboard.
+		if (Cluster.Count == 1)
+		{
+			if (bPIE && FirstComponent)
+			{
+				DrawPIEIcon(Canvas, FirstComponent, NearbyScripts[Cluster.FirstScript].ScreenPos);
+			}
+			
+			continue;
+		}
+		
+		// Outside of PIE the first script's billboard stands in for the cluster, the others are suppressed
+		const FVector2f ScreenPos = bPIE ? Cluster.GetScreenPos() : NearbyScripts[Cluster.FirstScript].ScreenPos;
+		
+		if (bPIE && FirstComponent)
+		{
+			DrawPIEIcon(Canvas, FirstComponent, ScreenPos);
+		}
+		
+		Canvas->Canvas->DrawShadowedString(ScreenPos.X + 12.0f, ScreenPos.Y - 20.0f, *FString::Printf(TEXT("%i"), Cluster.Count), GEngine->GetSmallFont(), FLinearColor::White);
+	}
+}
 
 TSharedPtr<SWidget> UBangoScriptsDebugDrawService::CreatePopupTitle(UBangoScriptComponent& ScriptComponent)
 { 
@@ -898,5 +1271,33 @@ TSharedPtr<SWidget> UBangoScriptsDebugDrawService::CreateRunButton(UBangoScriptC
 	});	
 }
 
+// ================================================================================================
+
+FBangoScripts_BillboardClusterViewExtension::FBangoScripts_BillboardClusterViewExtension(const FAutoRegister& AutoRegister, UBangoScriptsDebugDrawService* InService)
+	: FSceneViewExtensionBase(AutoRegister)
+	, Service(InService)
+{
+}
+
+// ----------------------------------------------
+
+void FBangoScripts_BillboardClusterViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView)
+{
+	if (const UBangoScriptsDebugDrawService* DebugDrawService = Service.Get())
+	{
+		InView.HiddenPrimitives.Append(DebugDrawService->SuppressedBillboards);
+	}
+}
+
+// ----------------------------------------------
+
+bool FBangoScripts_BillboardClusterViewExtension::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
+{
+	const UBangoScriptsDebugDrawService* DebugDrawService = Service.Get();
+	
+	return DebugDrawService && Context.Viewport && Context.Viewport == DebugDrawService->SuppressedBillboardsViewport && !DebugDrawService->SuppressedBillboards.IsEmpty();
+}
+
+// ----------------------------------------------
 
 #undef LOCTEXT_NAMESPACE
@@ -7,16 +7,21 @@
 #include "Components/ActorComponent.h"
 #include "Engine/Canvas.h"
 #include "Math/GenericOctree.h"
+#include "PrimitiveComponentId.h"
+#include "SceneViewExtension.h"
 
 #include "BangoScriptsDebugDrawService.generated.h"
 
 class AActor;
 class APlayerController;
 class FBangoScriptBlueprintEditor;
+class FLevelEditorViewportClient;
+class FViewport;
 class IMenu;
 class UBangoScriptComponent;
 class UCanvas;
 class USceneComponent;
+class UBangoScriptsDebugDrawService;
 struct FBangoDebugDrawCanvas;
 enum class EBangoScriptComponentRegisterStatus : uint8;
 
@@ -78,6 +83,9 @@ struct FBangoDebugDraw_ScriptComponentHover
 	// Do we have a focused component, but hover has not been consumed yet?
 	bool IsHoveredOrHoverPendingFor(UBangoScriptComponent* ScriptComponent) const;
 	
+	// Is a component focused but still waiting for its hover time to build the popup?
+	bool IsHoverPending() const;
+	
 	// Is there currently an active widget?
 	bool HasFocusedComponent() const;
 	
@@ -104,20 +112,83 @@ private:
 
 struct FBangoScripts_NearbyScript
 {
-	FBangoScripts_NearbyScript(UBangoScriptComponent* InComponent, float InMouseDistSqrd, FVector2f InScreenPos) 
+	FBangoScripts_NearbyScript(UBangoScriptComponent* InComponent, const FVector& InWorldPos) 
 		: Component(InComponent)
-		, MouseDistSqrd(InMouseDistSqrd)
-		, ScreenPos(InScreenPos){}
+		, WorldPos(InWorldPos) {}
+	
+	// Kept across frames, the component may be gone before the next query
+	TWeakObjectPtr<UBangoScriptComponent> Component;
+	FVector WorldPos;
+	
+	// Filled in by ProjectNearbyScripts when the queried viewport draws
+	FVector2f ScreenPos = FVector2f::ZeroVector;
+	bool bOnScreen = false;
+	
+	// Within the detail distance, gets hover controls and its own icon. Far scripts are drawn through IconClusters instead.
+	bool bDetailed = false;
+	
+	// Index into IconClusters, for far scripts on screen
+	int32 IconCluster = INDEX_NONE;
+};
+
+// Far script icons which share a screen cell, drawn as one icon with a count badge. Outside of PIE only the first script keeps its billboard.
+struct FBangoScripts_ScriptIconCluster
+{
+	FVector2f ScreenSum = FVector2f::ZeroVector;
+	int32 Count = 0;
+	
+	// Index into NearbyScripts of the first script in the cell, drawn as a plain icon if it is alone
+	int32 FirstScript = INDEX_NONE;
+	
+	FVector2f GetScreenPos() const { return ScreenSum / Count; }
+};
+
+// The viewport and camera that nearby scripts are gathered for
+struct FBangoScripts_NearbyScriptsView
+{
+	FViewport* Viewport = nullptr;
+	UWorld* World = nullptr;
+	
+	// One of these is set, depending on whether this is a PIE game viewport or a level editor viewport
+	APlayerController* PlayerController = nullptr;
+	FLevelEditorViewportClient* EditorViewportClient = nullptr;
+	
+	FVector CameraLocation = FVector::ZeroVector;
+	FRotator CameraRotation = FRotator::ZeroRotator;
+	
+	// Scripts are still gathered and drawn while the mouse is elsewhere, they just can't be hovered
+	bool bMouseInViewport = false;
+	FVector2f MouseScreenPos = FVector2f::ZeroVector;
+	
+	// Only needed when querying, building it needs the view matrices
+	FConvexVolume MakeCullingFrustum() const;
+};
+
+// Hides the billboards suppressed by UBangoScriptsDebugDrawService, only in the viewport their icon clusters were projected for
+class FBangoScripts_BillboardClusterViewExtension : public FSceneViewExtensionBase
+{
+public:
+	FBangoScripts_BillboardClusterViewExtension(const FAutoRegister& AutoRegister, UBangoScriptsDebugDrawService* InService);
+	
+	void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+	
+	void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
+	
+	void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
 	
-	UBangoScriptComponent* Component;
-	float MouseDistSqrd;
-	FVector2f ScreenPos;
+protected:
+	bool IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const override;
+	
+private:
+	TWeakObjectPtr<UBangoScriptsDebugDrawService> Service;
 };
 
 UCLASS()
 class UBangoScriptsDebugDrawService : public UEditorSubsystem, public FTickableEditorObject
 {
 	GENERATED_BODY()
+	
+	friend class FBangoScripts_BillboardClusterViewExtension;
 
 	bool bShowFlagEnabled;
 
@@ -133,8 +204,14 @@ class UBangoScriptsDebugDrawService : public UEditorSubsystem, public FTickableE
 	
 	void Tick(float DeltaTime) override;
 	
+	// Regathers NearbyScripts from the octree, but only once the camera moved or turned far enough, the octree changed or the view changed. Cheap otherwise.
 	void UpdateNearbyScripts();
 	
+	bool GetNearbyScriptsView(FBangoScripts_NearbyScriptsView& OutView) const;
+	
+	// Screen positions are only worked out when the queried viewport draws, using the view it draws with. Also sorts far scripts into IconClusters.
+	void ProjectNearbyScripts(const FSceneView& View);
+	
 	TStatId GetStatId() const override;
 	
 	TOctree2<FBangoScriptOctreeElement, FBangoScriptOctreeSemantics> ScriptComponentTree;
@@ -143,6 +220,9 @@ class UBangoScriptsDebugDrawService : public UEditorSubsystem, public FTickableE
 	// TODO | So instead we sub to GEngine->OnActorMoved and check EVERY ACTOR to see if they are involved in this debug draw. We store our own actors in this set to speed this up a bit.
 	UPROPERTY(Transient)
 	TSet<AActor*> ScriptOwners;
+	
+	// Script owners moved since the last update, see FlushMovedActors
+	TSet<TWeakObjectPtr<AActor>> PendingMovedActors;
 
 	FDelegateHandle DebugDrawHandle;
 	
@@ -151,6 +231,43 @@ private:
 	
 	TArray<FBangoScripts_NearbyScript> NearbyScripts;
 	
+	// Rebuilt every time NearbyScripts is projected
+	TArray<FBangoScripts_ScriptIconCluster> IconClusters;
+	
+	// Indices into NearbyScripts of detailed on-screen scripts, by screen cell. Cells are as big as the hover radius, so a hover test only needs the mouse's cell and its neighbours.
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> HoverGrid;
+	
+	// Bumped whenever a projection moved, added or removed any script on screen
+	uint32 ProjectionRevision = 0;
+	
+	// Billboards hidden because another script's billboard stands in for their icon cluster. Only hidden in the viewport the clusters were
+	// projected for, through BillboardClusterViewExtension; the components themselves stay visible.
+	TSet<FPrimitiveComponentId> SuppressedBillboards;
+	FViewport* SuppressedBillboardsViewport = nullptr;
+	
+	// What SuppressedBillboards was last worked out for, unset while nothing is suppressed on purpose
+	TOptional<uint32> SuppressionProjectionRevision;
+	
+	TSharedPtr<FBangoScripts_BillboardClusterViewExtension, ESPMode::ThreadSafe> BillboardClusterViewExtension;
+	
+	// What hover was last evaluated for
+	FVector2f LastHoverMouseScreenPos = FVector2f::ZeroVector;
+	uint32 LastHoverProjectionRevision = 0;
+	
+	// Bumped whenever an element is added to or removed from ScriptComponentTree
+	uint32 OctreeRevision = 0;
+	
+	// What NearbyScripts was last gathered for
+	FViewport* NearbyScriptsViewport = nullptr;
+	TWeakObjectPtr<UWorld> NearbyScriptsWorld;
+	FVector LastQueryCameraLocation = FVector::ZeroVector;
+	FRotator LastQueryCameraRotation = FRotator::ZeroRotator;
+	uint32 LastQueryOctreeRevision = 0;
+	double LastQueryTime = -1.0;
+	
+	FVector2f MouseScreenPos = FVector2f::ZeroVector;
+	bool bMouseInNearbyScriptsView = false;
+	
 private:
 	void OnBangoScriptRegistrationChange(UBangoScriptComponent* ScriptComponent, EBangoScriptComponentRegisterStatus RegistrationStatus);
 	
@@ -162,11 +279,30 @@ private:
 	
 	void OnGlobalActorMoved(AActor* Actor);
 	
+	// Drops all screen space data along with NearbyScripts
+	void ClearNearbyScripts();
+	
+	void RebuildHoverGrid();
+	
+	// Works out which billboards to hide in the drawn viewport: every far clustered script's but the first of each cluster
+	void UpdateSuppressedBillboards(bool bPIE);
+	
+	// Only when the clustered view goes away or clustering turns off, the mouse leaving the viewport keeps them hidden
+	void ReleaseSuppressedBillboards();
+	
+	// Moves the octree elements of every script on PendingMovedActors, once each. Element ids live on the components (see FBangoScriptOctreeSemantics::SetElementId), so this never searches the tree.
+	void FlushMovedActors();
+	
+	// Reinserts the component's element if its billboard moved
+	void UpdateElement(UBangoScriptComponent* ScriptComponent);
+	
 	bool DrawViewportHoverControls(UBangoScriptComponent* ScriptComponent, float MouseDistSqrd, const FVector2f& BillboardScreenPos, bool bPIE);
 
 	TSharedRef<SWidget> GetHoverMenuWidget(UBangoScriptComponent* ScriptComponent, bool bPIE);
 	
 	void DrawPIEIcon(UCanvas* Canvas, const UBangoScriptComponent* ScriptComponent, FVector2f ScreenPos);
+	
+	void DrawIconClusters(UCanvas* Canvas, bool bPIE);
 
 	FText GetLabelText(const UBangoScriptComponent& ScriptComponent);
 	
@@ -8,6 +8,7 @@
 #include "ToolMenus.h"
 #include "BangoScripts/Components/BangoActorIDComponent.h"
 #include "BangoScripts/Utility/BangoScriptsLog.h"
+#include "BangoScripts/Utility/BangoUtility.h"
 #include "BangoScripts_Editor/Private/Commands/BangoEditorActions.h"
 #include "Framework/Application/MenuStack.h"
 #include "Framework/Application/SlateApplication.h"
@@ -110,7 +111,7 @@ void FBangoEditorMenus::SetEditActorID(AActor* Actor, bool bBlocking)
 		//UE_LOG(LogTemp, Display, TEXT("%f, %f"), ScreenPos.X, ScreenPos.Y);
 	}
 
-	UBangoActorIDComponent* ExistingIDComponent = Actor->FindComponentByClass<UBangoActorIDComponent>();
+	UBangoActorIDComponent* ExistingIDComponent = Bango::Utilities::GetActorIDComponent(Actor);
 	FName ExistingName = NAME_None;
 		
 	if (IsValid(ExistingIDComponent))
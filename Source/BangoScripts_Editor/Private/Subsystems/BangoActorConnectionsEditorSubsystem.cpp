@@ -0,0 +1,296 @@
+﻿#include "BangoActorConnectionsEditorSubsystem.h"
+
+#include "Editor.h"
+#include "BangoScripts/Core/BangoScriptBlueprint.h"
+#include "BangoScripts/Core/BangoScriptContainer.h"
+#include "BangoScripts/Interfaces/BangoScriptContainerObjectInterface.h"
+#include "BangoScripts/Uncooked/K2Nodes/K2Node_BangoFindActor.h"
+#include "EdGraph/EdGraph.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "WorldPartition/ActorDescContainerInstance.h"
+#include "WorldPartition/WorldPartition.h"
+
+namespace Bango::ActorConnections
+{
+	// Goes through the actor descriptors, which exist whether or not the actor is loaded
+	static FName GetRuntimeGrid(const UWorld* World, const FSoftObjectPath& ActorPath)
+	{
+		UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+		UActorDescContainerInstance* ActorDescContainer = WorldPartition ? WorldPartition->GetActorDescContainerInstance() : nullptr;
+		
+		if (!ActorDescContainer || ActorPath.IsNull())
+		{
+			return NAME_None;
+		}
+		
+		const FWorldPartitionActorDescInstance* ActorDesc = ActorDescContainer->GetActorDescInstanceByPath(ActorPath);
+		
+		return ActorDesc ? ActorDesc->GetRuntimeGrid() : NAME_None;
+	}
+	
+	static FName GetRuntimeGrid(const AActor* Actor)
+	{
+		return Actor ? GetRuntimeGrid(Actor->GetWorld(), FSoftObjectPath(Actor)) : NAME_None;
+	}
+}
+
+// ----------------------------------------------
+
+bool FBangoActorConnection::IsFocused() const
+{
+	for (const TWeakObjectPtr<const UK2Node_BangoFindActor>& Node : Nodes)
+	{
+		if (Node.IsValid() && GFrameCounter - Node->LastSelectedFrame < 3)
+		{
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+// ----------------------------------------------
+
+bool FBangoActorConnection::UpdatePosition()
+{
+	const AActor* Actor = Target.Get();
+	
+	if (!Actor)
+	{
+		bHasPosition = false;
+		return false;
+	}
+	
+	// Target was loaded since the list was built
+	if (!bResolvedWhileLoaded)
+	{
+		ResolveRuntimeGrid(Actor->GetWorld());
+	}
+	
+	const FVector ActorLocation = Actor->GetActorLocation();
+	
+	if (!bHasPosition || !ActorLocation.Equals(LastActorLocation))
+	{
+		FVector BoxExtents;
+		Actor->GetActorBounds(false, LastPosition, BoxExtents);
+		
+		LastActorLocation = ActorLocation;
+		bHasPosition = true;
+	}
+	
+	return true;
+}
+
+// ----------------------------------------------
+
+void FBangoActorConnection::ResolveRuntimeGrid(const UWorld* World)
+{
+	RuntimeGrid = Bango::ActorConnections::GetRuntimeGrid(World, Target.ToSoftObjectPath());
+	bResolvedWhileLoaded = Target.IsValid();
+}
+
+// ----------------------------------------------
+
+void UBangoActorConnectionsEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &ThisClass::OnObjectPropertyChanged);
+	FEditorDelegates::PostUndoRedo.AddUObject(this, &ThisClass::OnPostUndoRedo);
+}
+
+// ----------------------------------------------
+
+void UBangoActorConnectionsEditorSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+	FEditorDelegates::PostUndoRedo.RemoveAll(this);
+	
+	for (TPair<TObjectKey<UBangoScriptBlueprint>, FBangoActorConnectionList>& Pair : ListsByBlueprint)
+	{
+		UnbindGraphs(Pair.Value);
+		
+		if (UBangoScriptBlueprint* Blueprint = Pair.Key.ResolveObjectPtr())
+		{
+			Blueprint->OnChanged().RemoveAll(this);
+			Blueprint->OnCompiled().RemoveAll(this);
+		}
+	}
+	
+	ListsByBlueprint.Empty();
+	
+	Super::Deinitialize();
+}
+
+// ----------------------------------------------
+
+FBangoActorConnectionList* UBangoActorConnectionsEditorSubsystem::GetConnections(UBangoScriptBlueprint& Blueprint)
+{
+	UBangoActorConnectionsEditorSubsystem* Subsystem = GEditor ? GEditor->GetEditorSubsystem<UBangoActorConnectionsEditorSubsystem>() : nullptr;
+	
+	if (!Subsystem)
+	{
+		return nullptr;
+	}
+	
+	FBangoActorConnectionList* List = Subsystem->ListsByBlueprint.Find(&Blueprint);
+	
+	if (!List)
+	{
+		// Drop lists of blueprints that are gone
+		for (auto It = Subsystem->ListsByBlueprint.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		
+		List = &Subsystem->ListsByBlueprint.Add(&Blueprint);
+		
+		Blueprint.OnChanged().AddUObject(Subsystem, &ThisClass::Invalidate);
+		Blueprint.OnCompiled().AddUObject(Subsystem, &ThisClass::Invalidate);
+	}
+	
+	const IBangoScriptHolderInterface* ScriptHolder = Blueprint.GetScriptHolder();
+	const int32 NumHardActorRefs = ScriptHolder ? ScriptHolder->GetScriptContainer().HardActorRefs.Num() : 0;
+	
+	if (List->bDirty || List->NumHardActorRefs != NumHardActorRefs)
+	{
+		Subsystem->Rebuild(Blueprint, *List);
+	}
+	
+	return List;
+}
+
+// ----------------------------------------------
+
+void UBangoActorConnectionsEditorSubsystem::InvalidateAll()
+{
+	for (TPair<TObjectKey<UBangoScriptBlueprint>, FBangoActorConnectionList>& Pair : ListsByBlueprint)
+	{
+		Pair.Value.bDirty = true;
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoActorConnectionsEditorSubsystem::Rebuild(UBangoScriptBlueprint& Blueprint, FBangoActorConnectionList& List)
+{
+	using namespace Bango::ActorConnections;
+	
+	UnbindGraphs(List);
+	
+	List.Connections.Reset();
+	List.bDirty = false;
+	
+	const IBangoScriptHolderInterface* ScriptHolder = Blueprint.GetScriptHolder();
+	const TSet<TObjectPtr<AActor>>* HardActorRefs = ScriptHolder ? &ScriptHolder->GetScriptContainer().HardActorRefs : nullptr;
+	
+	List.NumHardActorRefs = HardActorRefs ? HardActorRefs->Num() : 0;
+	
+	// Targets may not be loaded, so match them against the hard refs by path
+	TSet<FSoftObjectPath> HardActorRefPaths;
+	
+	if (HardActorRefs)
+	{
+		HardActorRefPaths.Reserve(HardActorRefs->Num());
+		
+		for (const TObjectPtr<AActor>& HardActorRef : *HardActorRefs)
+		{
+			if (HardActorRef)
+			{
+				HardActorRefPaths.Add(FSoftObjectPath(HardActorRef.Get()));
+			}
+		}
+	}
+	
+	const AActor* OwnerActor = Blueprint.GetOwnerActor().Get();
+	const UWorld* World = OwnerActor ? OwnerActor->GetWorld() : GEditor->GetEditorWorldContext().World();
+	
+	List.OwnerRuntimeGrid = GetRuntimeGrid(OwnerActor);
+	
+	TMap<TSoftObjectPtr<AActor>, int32> ConnectionIndices;
+	
+	TArray<UEdGraph*> Graphs;
+	Blueprint.GetAllGraphs(Graphs);
+	
+	for (UEdGraph* Graph : Graphs)
+	{
+		List.GraphHandles.Emplace(Graph, Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateWeakLambda(this, [this, WeakBlueprint = TWeakObjectPtr<UBlueprint>(&Blueprint)] (const FEdGraphEditAction&)
+		{
+			Invalidate(WeakBlueprint.Get());
+		})));
+		
+		TArray<UK2Node_BangoFindActor*> FindActorNodes;
+		Graph->GetNodesOfClass(FindActorNodes);
+		
+		for (const UK2Node_BangoFindActor* Node : FindActorNodes)
+		{
+			const TSoftObjectPtr<AActor> TargetActor = Node->GetTargetActor();
+			
+			if (TargetActor.IsNull())
+			{
+				continue;
+			}
+			
+			int32& ConnectionIndex = ConnectionIndices.FindOrAdd(TargetActor, INDEX_NONE);
+			
+			if (ConnectionIndex == INDEX_NONE)
+			{
+				ConnectionIndex = List.Connections.AddDefaulted();
+				
+				FBangoActorConnection& Connection = List.Connections[ConnectionIndex];
+				Connection.Target = TargetActor;
+				Connection.bHardRef = HardActorRefPaths.Contains(TargetActor.ToSoftObjectPath());
+				Connection.ResolveRuntimeGrid(World);
+				Connection.UpdatePosition();
+			}
+			
+			List.Connections[ConnectionIndex].Nodes.Add(Node);
+		}
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoActorConnectionsEditorSubsystem::Invalidate(UBlueprint* Blueprint)
+{
+	if (FBangoActorConnectionList* List = ListsByBlueprint.Find(Cast<UBangoScriptBlueprint>(Blueprint)))
+	{
+		List->bDirty = true;
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoActorConnectionsEditorSubsystem::UnbindGraphs(FBangoActorConnectionList& List)
+{
+	for (TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>& GraphHandle : List.GraphHandles)
+	{
+		if (UEdGraph* Graph = GraphHandle.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(GraphHandle.Value);
+		}
+	}
+	
+	List.GraphHandles.Reset();
+}
+
+// ----------------------------------------------
+
+void UBangoActorConnectionsEditorSubsystem::OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (const UK2Node_BangoFindActor* Node = Cast<UK2Node_BangoFindActor>(Object))
+	{
+		Invalidate(FBlueprintEditorUtils::FindBlueprintForNode(Node));
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoActorConnectionsEditorSubsystem::OnPostUndoRedo()
+{
+	InvalidateAll();
+}
@@ -0,0 +1,93 @@
+﻿#pragma once
+
+#include "EditorSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "BangoActorConnectionsEditorSubsystem.generated.h"
+
+class AActor;
+class UBangoScriptBlueprint;
+class UBlueprint;
+class UEdGraph;
+class UK2Node_BangoFindActor;
+class UWorld;
+
+// One actor referenced by FindActor nodes of a script
+struct FBangoActorConnection
+{
+	TSoftObjectPtr<AActor> Target;
+	
+	// World Partition runtime grid of the target, NAME_None outside of World Partition. Looked up by path, so unloaded targets have it too.
+	FName RuntimeGrid = NAME_None;
+	
+	bool bHardRef = false;
+	
+	// Whether the target was loaded the last time RuntimeGrid was resolved. The first UpdatePosition that finds it loaded resolves it again.
+	bool bResolvedWhileLoaded = false;
+	
+	// Bounds origin of the target, refreshed only when its location changes
+	FVector LastPosition = FVector::ZeroVector;
+	
+	FVector LastActorLocation = FVector::ZeroVector;
+	
+	bool bHasPosition = false;
+	
+	// Nodes pointing at this target, their selection highlights the connection
+	TArray<TWeakObjectPtr<const UK2Node_BangoFindActor>, TInlineAllocator<1>> Nodes;
+	
+	// Any of its nodes was selected in the graph editor within the last few frames
+	bool IsFocused() const;
+	
+	// Returns false if the target isn't loaded
+	bool UpdatePosition();
+	
+	void ResolveRuntimeGrid(const UWorld* World);
+};
+
+// Everything DebugDrawActorConnections needs about one script blueprint
+struct FBangoActorConnectionList
+{
+	TArray<FBangoActorConnection> Connections;
+	
+	FName OwnerRuntimeGrid = NAME_None;
+	
+	// Used to notice hard/soft toggles, which don't touch the graph
+	int32 NumHardActorRefs = 0;
+	
+	bool bDirty = true;
+	
+	TArray<TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>> GraphHandles;
+};
+
+/**
+ * Caches the actor connections of each script blueprint for the viewport visualization. A list is rebuilt from the blueprint's FindActor nodes only
+ * after one of its graphs, the blueprint or one of its FindActor nodes changed, or it was compiled; drawing a frame just reads the cache.
+ */
+UCLASS()
+class UBangoActorConnectionsEditorSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+	
+public:
+	void Initialize(FSubsystemCollectionBase& Collection) override;
+	
+	void Deinitialize() override;
+	
+	static FBangoActorConnectionList* GetConnections(UBangoScriptBlueprint& Blueprint);
+	
+	// Marks every list for rebuild
+	void InvalidateAll();
+	
+protected:
+	TMap<TObjectKey<UBangoScriptBlueprint>, FBangoActorConnectionList> ListsByBlueprint;
+	
+	void Rebuild(UBangoScriptBlueprint& Blueprint, FBangoActorConnectionList& List);
+	
+	void Invalidate(UBlueprint* Blueprint);
+	
+	void UnbindGraphs(FBangoActorConnectionList& List);
+	
+	void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+	
+	void OnPostUndoRedo();
+};
@@ -203,9 +203,16 @@ void UBangoLevelScriptsEditorSubsystem::OnObjectRenamed(UObject* RenamedObject,
 
 			if (Blueprint)
 			{
+				FString NewPrivateName = Bango::Editor::GetLocalScriptName(ScriptHolder->_getUObject()->GetName());
+				
+				// Nothing to rename and nothing to recompile, leave the package alone
+				if (Blueprint->GetName() == NewPrivateName && Blueprint->IsCompiledGraphUpToDate())
+				{
+					return;
+				}
+				
 				(void)Blueprint->MarkPackageDirty();
 				
-				FString NewPrivateName = Bango::Editor::GetLocalScriptName(ScriptHolder->_getUObject()->GetName());
 				Blueprint->Rename(*NewPrivateName, nullptr, REN_DontCreateRedirectors | REN_NonTransactional);
 
 				Blueprint->Modify();
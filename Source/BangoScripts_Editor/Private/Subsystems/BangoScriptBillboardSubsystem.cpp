@@ -2,7 +2,9 @@
 
 #include "Editor.h"
 #include "TextureResource.h"
+#include "LevelEditorViewport.h"
 #include "BangoScripts/EditorTooling/BangoDebugUtility.h"
+#include "BangoScripts/EditorTooling/BangoDevSettings.h"
 #include "BangoScripts/EditorTooling/BangoEditorDelegates.h"
 #include "BangoScripts/Interfaces/BangoScriptContainerObjectInterface.h"
 #include "Engine/Texture2D.h"
@@ -53,6 +55,17 @@ void UBangoScriptBillboardSubsystem::OnCustomBillboardRequested(IBangoScriptHold
 
 void UBangoScriptBillboardSubsystem::Tick()
 {
+	for (int32 i = ActiveGenerators.Num() - 1; i >= 0; --i)
+	{
+		if (!ActiveGenerators[i]->IsRunning())
+		{
+			PendingUploads.Add(ActiveGenerators[i]);
+			ActiveGenerators.RemoveAtSwap(i);
+		}
+	}
+	
+	UploadFinished();
+	
 	// All done - stop processing
 	if (QueuedRequests.IsEmpty())
 	{
@@ -60,41 +73,102 @@ void UBangoScriptBillboardSubsystem::Tick()
 		return;
 	}
 	
-	if (ActiveGenerator.IsValid())
+	StartGenerators();
+}
+
+void UBangoScriptBillboardSubsystem::StartGenerators()
+{
+	const int32 MaxGenerators = UBangoScriptsDeveloperSettings::GetMaxConcurrentBillboardGenerators();
+	
+	if (ActiveGenerators.Num() >= MaxGenerators)
+	{
+		return;
+	}
+	
+	// Anything in view goes before anything out of view
+	const double OutOfViewPenalty = UE_BIG_NUMBER;
+	
+	const FLevelEditorViewportClient* ViewportClient = GCurrentLevelEditingViewportClient;
+	const bool bHasView = ViewportClient && ViewportClient->IsPerspective();
+	
+	const FVector ViewLocation = bHasView ? ViewportClient->GetViewLocation() : FVector::ZeroVector;
+	const FVector ViewForward = bHasView ? ViewportClient->GetViewRotation().Vector() : FVector::ForwardVector;
+	const double CosHalfFOV = bHasView ? FMath::Cos(FMath::DegreesToRadians(0.5 * ViewportClient->ViewFOV)) : 0.0;
+	
+	auto GetPriority = [&] (const FBangoBillboardRequest& Request)
 	{
-		if (ActiveGenerator->IsRunning())
+		if (!bHasView)
 		{
-			// Let the active generator keep running
-			return;
+			return 0.0;
 		}
-		else
+		
+		double Priority = TNumericLimits<double>::Max();
+		
+		for (const FObjectKey& RequesterKey : Request.RequestingObjects)
 		{
-			// Broadcast complete generator
-			OnGenerationComplete(ActiveGenerator);
+			IBangoScriptHolderInterface* ScriptHolder = Cast<IBangoScriptHolderInterface>(RequesterKey.ResolveObjectPtr());
+			
+			if (!ScriptHolder)
+			{
+				continue;
+			}
+			
+			const FVector ToRequester = ScriptHolder->GetDebugDrawOrigin() - ViewLocation;
+			const double Distance = ToRequester.Size();
+			const bool bInView = (ToRequester | ViewForward) >= CosHalfFOV * Distance;
+			
+			Priority = FMath::Min(Priority, bInView ? Distance : OutOfViewPenalty + Distance);
+		}
+		
+		return Priority;
+	};
+	
+	TArray<TPair<double, FBangoBillboardRequest*>> Candidates;
+	
+	for (auto& [SoftTexture, Request] : QueuedRequests)
+	{
+		if (!Request.bStarted)
+		{
+			Candidates.Emplace(GetPriority(Request), &Request);
 		}
 	}
 	
-	// Activate a generator
-	for (auto [SoftTexture, Request] : QueuedRequests)
+	Candidates.Sort([] (const TPair<double, FBangoBillboardRequest*>& A, const TPair<double, FBangoBillboardRequest*>& B) { return A.Key < B.Key; });
+	
+	for (int32 i = 0; i < Candidates.Num() && ActiveGenerators.Num() < MaxGenerators; ++i)
 	{
-		ActiveGenerator = Request.Generator;
-		ActiveGenerator->Run();
-		break;
+		FBangoBillboardRequest& Request = *Candidates[i].Value;
+		
+		Request.bStarted = true;
+		Request.Generator->Run();
+		
+		ActiveGenerators.Add(Request.Generator);
 	}
 }
 
-void UBangoScriptBillboardSubsystem::OnGenerationComplete(TSharedPtr<FBangoAsyncBillboardGenerator> Generator)
+void UBangoScriptBillboardSubsystem::UploadFinished()
 {
-	ActiveGenerator.Reset();
+	const int32 NumUploads = FMath::Min(PendingUploads.Num(), UBangoScriptsDeveloperSettings::GetBillboardUploadsPerFrame());
 	
+	for (int32 i = 0; i < NumUploads; ++i)
+	{
+		OnGenerationComplete(PendingUploads[i]);
+	}
+	
+	PendingUploads.RemoveAt(0, NumUploads);
+}
+
+void UBangoScriptBillboardSubsystem::OnGenerationComplete(TSharedPtr<FBangoAsyncBillboardGenerator> Generator)
+{
 	FBangoBillboardRequest* Request = QueuedRequests.Find(Generator->GetTextureSource());
 	check(Request);
 	
-	if (Request)
+	if (Request && Generator->HasGeneratedTexture())
 	{
-		TMap<TSoftObjectPtr<UTexture2D>, TStrongObjectPtr<UTexture2D>> Copy1 = FBangoScriptBillboards::GeneratedBillboards;
-		FBangoScriptBillboards::GeneratedBillboards.Add(Generator->GetTextureSource(), TStrongObjectPtr<UTexture2D>(Generator->GetGeneratedTexture()) );
-		TMap<TSoftObjectPtr<UTexture2D>, TStrongObjectPtr<UTexture2D>> Copy2 = FBangoScriptBillboards::GeneratedBillboards;
+		UTexture2D* GeneratedTexture = Generator->GetGeneratedTexture();
+		GeneratedTexture->UpdateResource();
+		
+		FBangoScriptBillboards::GeneratedBillboards.Add(Generator->GetTextureSource(), TStrongObjectPtr<UTexture2D>(GeneratedTexture));
 
 		auto Array = Request->RequestingObjects.Array();
 		
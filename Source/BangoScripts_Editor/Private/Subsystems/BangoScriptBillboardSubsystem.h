@@ -14,6 +14,7 @@ struct FBangoBillboardRequest
 {
 	TSet<FObjectKey> RequestingObjects; // IBangoScriptHolderInterface implementers
 	TSharedPtr<FBangoAsyncBillboardGenerator> Generator = nullptr;
+	bool bStarted = false;
 };
 
 UCLASS()
@@ -22,9 +23,14 @@ class UBangoScriptBillboardSubsystem : public UEditorSubsystem
 	GENERATED_BODY()
 
 protected:
+	// Keyed by overlay, the only input that varies, so every requester of the same overlay shares one generator. Requests stay here until their texture is uploaded.
 	TMap<TSoftObjectPtr<UTexture2D>, FBangoBillboardRequest> QueuedRequests;
 
-	TSharedPtr<FBangoAsyncBillboardGenerator> ActiveGenerator;
+	// Up to UBangoScriptsDeveloperSettings::GetMaxConcurrentBillboardGenerators()
+	TArray<TSharedPtr<FBangoAsyncBillboardGenerator>> ActiveGenerators;
+	
+	// Finished generators whose texture hasn't been uploaded yet
+	TArray<TSharedPtr<FBangoAsyncBillboardGenerator>> PendingUploads;
 
 	FTimerHandle TickTimerHandle;
 	
@@ -32,6 +38,12 @@ protected:
 	
 	void Tick();
 	
+	// Fills free generator slots with the queued requests closest to the view, in view ones first
+	void StartGenerators();
+	
+	// Uploads a batch of finished textures and updates their requesters' billboards
+	void UploadFinished();
+	
 	void OnGenerationComplete(TSharedPtr<FBangoAsyncBillboardGenerator> Generator);
 	
 protected:
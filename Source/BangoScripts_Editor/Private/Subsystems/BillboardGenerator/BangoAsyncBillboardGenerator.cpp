@@ -3,6 +3,8 @@
 #include "TextureResource.h"
 #include "AssetUtils/Texture2DUtil.h"
 #include "Async/Async.h"
+#include "BangoBillboardCache.h"
+#include "BangoBillboardCompositor.h"
 #include "BangoScripts/EditorTooling/BangoDebugUtility.h"
 #include "BangoScripts/EditorTooling/BangoScriptsEditorLog.h"
 #include "Engine/AssetManager.h"
@@ -10,6 +12,42 @@
 #include "Engine/Texture2D.h"
 #include "Image/ImageBuilder.h"
 
+namespace Bango::BillboardGenerator
+{
+	// Copied out of the base sprite the first time it's needed, so generators don't each lock its mip
+	struct FBaseImage
+	{
+		FIntPoint Size = FIntPoint::ZeroValue;
+		TArray<FColor> Pixels;
+		FBlake3Hash Hash;
+	};
+	
+	// Game thread only
+	const FBaseImage& GetBaseImage()
+	{
+		static FBaseImage BaseImage;
+		
+		if (BaseImage.Pixels.IsEmpty())
+		{
+			// This is always stored in a strong pointer elsewhere so I can be lax with it
+			UTexture2D* Base = Bango::Debug::GetDefaultScriptBillboardSprite();
+			
+			BaseImage.Size = FIntPoint(Base->GetSizeX(), Base->GetSizeY());
+			
+			FTexture2DMipMap& BaseMip = Base->GetPlatformData()->Mips[0];
+			const FColor* BasePixels = static_cast<const FColor*>(BaseMip.BulkData.LockReadOnly());
+			
+			BaseImage.Pixels = TArray<FColor>(BasePixels, BaseImage.Size.X * BaseImage.Size.Y);
+			
+			BaseMip.BulkData.Unlock();
+			
+			BaseImage.Hash = FBlake3::HashBuffer(BaseImage.Pixels.GetData(), BaseImage.Pixels.NumBytes());
+		}
+		
+		return BaseImage;
+	}
+}
+
 FBangoAsyncBillboardGenerator::FBangoAsyncBillboardGenerator(const TSoftObjectPtr<UTexture2D>& InOverlayTexture)
 	: OverlayTexture(InOverlayTexture)
 {
@@ -45,23 +83,11 @@ void FBangoAsyncBillboardGenerator::OnOverlayLoaded()
 	
 	TSharedPtr<FBangoAsyncBillboardGenerator> SharedThis = AsShared();
 	
-	UE::Geometry::TImageBuilder<FVector4f> OverlayParsedImage;
-	if (!UE::AssetUtils::ReadTexture(OverlayTexture.Get(), OverlayParsedImage))
-	{
-		UE_LOG(LogBangoEditor, Error, TEXT("Could not load overlay texture: %s"), *SharedThis->OverlayTexture.ToString());
-		SharedThis->bRunning = false;
-		return;
-	}
-
-	bool bOverlaySRGB = OverlayTexture->SRGB;
-	
-	// This is always stored in a strong pointer elsewhere so I can be lax with it
-	UTexture2D* Base = Bango::Debug::GetDefaultScriptBillboardSprite();
+	const Bango::BillboardGenerator::FBaseImage& BaseImage = Bango::BillboardGenerator::GetBaseImage();
 	
-	int32 BaseWidth = Base->GetSizeX();
-	int32 BaseHeight = Base->GetSizeY();
+	CacheKey = Bango::BillboardCache::MakeKey(*OverlayTexture.Get(), BaseImage.Hash);
 	
-	UTexture2D* Result = UTexture2D::CreateTransient(BaseWidth, BaseHeight, PF_B8G8R8A8);
+	UTexture2D* Result = UTexture2D::CreateTransient(BaseImage.Size.X, BaseImage.Size.Y, PF_B8G8R8A8);
 	Result->MipGenSettings = TMGS_NoMipmaps;
 	Result->AddressX = TA_Clamp;
 	Result->AddressY = TA_Clamp;
@@ -71,16 +97,52 @@ void FBangoAsyncBillboardGenerator::OnOverlayLoaded()
 	Result->SRGB = true;
 	
 	TStrongObjectPtr<UTexture2D> ResultStrong(Result);
+	
+	GenerationTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [SharedThis, ResultStrong, Size = BaseImage.Size]
+	{
+		FTexture2DMipMap& ResultMipMap = ResultStrong->GetPlatformData()->Mips[0];
+		FColor* ResultPixels = static_cast<FColor*>(ResultMipMap.BulkData.Lock(LOCK_READ_WRITE));
+		
+		const bool bCached = Bango::BillboardCache::Load(SharedThis->CacheKey, Size, ResultPixels);
+		
+		ResultMipMap.BulkData.Unlock();
+		
+		AsyncTask(ENamedThreads::GameThread, [SharedThis, ResultStrong, bCached]
+		{
+			if (bCached)
+			{
+				SharedThis->Finish(ResultStrong);
+			}
+			else
+			{
+				SharedThis->Generate(ResultStrong);
+			}
+		});
+	});
+}
+
+void FBangoAsyncBillboardGenerator::Generate(TStrongObjectPtr<UTexture2D> ResultStrong)
+{
+	TSharedPtr<FBangoAsyncBillboardGenerator> SharedThis = AsShared();
+	
+	UE::Geometry::TImageBuilder<FVector4f> OverlayParsedImage;
+	if (!OverlayTexture.IsValid() || !UE::AssetUtils::ReadTexture(OverlayTexture.Get(), OverlayParsedImage))
+	{
+		UE_LOG(LogBangoEditor, Error, TEXT("Could not load overlay texture: %s"), *SharedThis->OverlayTexture.ToString());
+		SharedThis->bRunning = false;
+		return;
+	}
+
+	bool bOverlaySRGB = OverlayTexture->SRGB;
+	
+	// Lives for the whole session
+	const Bango::BillboardGenerator::FBaseImage* BaseImage = &Bango::BillboardGenerator::GetBaseImage();
     
-	GenerationTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [SharedThis, OverlayParsedImage, Base, ResultStrong, bOverlaySRGB]
+	GenerationTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [SharedThis, OverlayParsedImage, BaseImage, ResultStrong, bOverlaySRGB]
 	{
 		FTaskTagScope Scope(ETaskTag::EParallelRenderingThread);
 		
-		FTexture2DMipMap& BaseMip = Base->GetPlatformData()->Mips[0];
-		FColor* BasePixels = static_cast<FColor*>(BaseMip.BulkData.Lock(LOCK_READ_ONLY));
-
-		int32 BaseWidth = Base->GetSizeX();
-		int32 BaseHeight = Base->GetSizeY();
+		const FIntPoint BaseSize = BaseImage->Size;
 
 		FTexture2DMipMap& ResultMipMap = ResultStrong->GetPlatformData()->Mips[0];
 		FColor* ResultPixels = static_cast<FColor*>(ResultMipMap.BulkData.Lock(LOCK_READ_WRITE));
@@ -88,118 +150,34 @@ void FBangoAsyncBillboardGenerator::OnOverlayLoaded()
 		// ------------------------------------------
 		// Fill it with the original data
 		
-		for (int32 BaseY = 0; BaseY < BaseHeight; ++BaseY)
-		{
-			for (int32 BaseX = 0; BaseX < BaseWidth; ++BaseX)
-			{
-				int32 BaseIndex = BaseX + BaseY * BaseWidth;
-				ResultPixels[BaseIndex] = BasePixels[BaseIndex];
-				ResultPixels[BaseIndex].R *= 0.75f; // Darken the normal icon a bit
-				ResultPixels[BaseIndex].G *= 0.75f; // Darken the normal icon a bit
-				ResultPixels[BaseIndex].B *= 0.75f; // Darken the normal icon a bit
-				// ResultPixels[BaseIndex].A *= 0.5f; // Fade the normal icon a bit
-			}
-		}
+		Bango::Billboard::DarkenBase(BaseImage->Pixels.GetData(), ResultPixels, BaseSize.X * BaseSize.Y);
 		
 		// ------------------------------------------
 		// Build the final overlay texture
 		
-		int32 OverlayTextureWidth = OverlayParsedImage.GetDimensions().GetWidth();
-		int32 OverlayTextureHeight = OverlayParsedImage.GetDimensions().GetHeight();
+		const FIntPoint OverlayDrawSize = Bango::Billboard::GetOverlayDrawSize(BaseSize);
 		
-		int32 OverlayHorizOffset = BaseWidth * 1 / 4;
-		int32 OverlayVertOffset = BaseHeight * 1 / 4;
-		int32 OverlayPadding = 1.0; // We pad the top-right by a pixel to avoid border wrap issue
+		TArray<FIntPoint> Offsets;
+		Bango::Billboard::GetOverlayOffsets(BaseSize, Offsets);
 		
-		// We need to apply overlay onto each quadrant.
-		TArray<FIntPoint> Offsets = 
-		{
-			// Top-left overlay origin
-			{ 1 * OverlayHorizOffset - OverlayPadding, 0 * OverlayVertOffset + OverlayPadding },
-			
-			// Top-right overlay origin
-			{ 3 * OverlayHorizOffset - OverlayPadding, 0 * OverlayVertOffset + OverlayPadding },
-			
-			// Bottom-left overlay origin
-			{ 1 * OverlayHorizOffset - OverlayPadding, 2 * OverlayVertOffset + OverlayPadding },
-			
-			// Bottom-right overlay origin
-			{ 3 * OverlayHorizOffset - OverlayPadding, 2 * OverlayVertOffset + OverlayPadding },
-		};
+		TArray<FColor> OverlayTile;
+		Bango::Billboard::ResampleOverlay(OverlayParsedImage, bOverlaySRGB, OverlayDrawSize, OverlayTile);
 		
-		int32 OverlayDrawWidth = BaseWidth / 4;
-		int32 OverlayDrawHeight = BaseHeight / 4;
+		Bango::Billboard::CompositeOverlay(ResultPixels, BaseSize, OverlayTile, OverlayDrawSize, Offsets);
 		
-		for (FIntPoint BaseOffset : Offsets)
-		{
-			int32 OverlayXStart = BaseOffset.X;
-			int32 OverlayXEnd = BaseOffset.X + OverlayDrawWidth;
-			int32 OverlayYStart = BaseOffset.Y;
-			int32 OverlayYEnd = BaseOffset.Y + OverlayDrawHeight;
-
-			for (int32 PixelY = OverlayYStart; PixelY < OverlayYEnd; ++PixelY)
-			{
-				for (int32 PixelX = 0; PixelX < OverlayXEnd; ++PixelX)
-				{
-					int32 PixelIndex = PixelX + PixelY * BaseWidth;
-				
-					// Transfer the base pixel coordinates into overlay texure coordinates
-					float OverlayXLerp = float(PixelX - OverlayXStart) / float(OverlayXEnd - OverlayXStart);
-					float OverlayYLerp = float(PixelY - OverlayYStart) / float(OverlayYEnd - OverlayYStart);
-				
-					if (OverlayXLerp < 0.0f || OverlayXLerp > 1.0f || OverlayYLerp < 0.0f || OverlayYLerp > 1.0f)
-					{
-						continue;
-					}
-					else
-					{
-						int32 OverlayTexX = FMath::Clamp(OverlayXLerp * OverlayTextureWidth, 0, OverlayTextureWidth - 1);
-						int32 OverlayTexY = FMath::Clamp(OverlayYLerp * OverlayTextureHeight, 0, OverlayTextureHeight - 1);
-						
-						// Pixel 1 = base pixel
-						// Pixel 2 = overlay pixel
-						FVector4f P1 = ResultPixels[PixelIndex].ReinterpretAsLinear();
-						FVector4f P2 = OverlayParsedImage.GetPixel(OverlayTexX, OverlayTexY);
-
-						// Auto-convert overlay texture to sRGB if needed (maybe I should not do this?)
-						P2 = FLinearColor(FLinearColor(P2).ToFColor(bOverlaySRGB).ReinterpretAsLinear());
-						
-						float a2 = P2[3];
-						float a1 = P1[3];
-
-						float One = 1.0f;
-						
-						FVector3f C1(P1.X, P1.Y, P1.Z);
-						FVector3f C2(P2.X, P2.Y, P2.Z);
-
-						float ao = a2 + a1 * (One - a2);
-						FVector3f Co;
-						
-						if (ao < KINDA_SMALL_NUMBER)
-						{
-							Co = FVector4f(0.0f);
-						}
-						else
-						{
-							Co = (C2 * a2 + C1 * a1 * (One - a2)) / ao; 
-						}
-
-						FVector4f Cof(Co.X, Co.Y, Co.Z, ao);
-						
-						ResultPixels[PixelIndex] = FLinearColor(Cof).ToFColor(false);
-					}
-				}
-			}
-		}
+		Bango::BillboardCache::Save(SharedThis->CacheKey, BaseSize, ResultPixels);
 	
-		BaseMip.BulkData.Unlock();
 		ResultMipMap.BulkData.Unlock();
-		SharedThis->GeneratedBillboardTexture = ResultStrong;
 		
-		AsyncTask(ENamedThreads::GameThread, [SharedThis]
+		AsyncTask(ENamedThreads::GameThread, [SharedThis, ResultStrong]
 		{
-			SharedThis->bRunning = false;
-			SharedThis->GeneratedBillboardTexture->UpdateResource();
+			SharedThis->Finish(ResultStrong);
 		});
 	});
 }
+
+void FBangoAsyncBillboardGenerator::Finish(TStrongObjectPtr<UTexture2D> Result)
+{
+	GeneratedBillboardTexture = Result;
+	bRunning = false;
+}
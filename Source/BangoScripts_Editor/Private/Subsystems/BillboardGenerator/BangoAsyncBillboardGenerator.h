@@ -18,6 +18,10 @@ public:
 	
 	TSoftObjectPtr<UTexture2D> GetTextureSource() const { return OverlayTexture; }
 	
+	// False if generation failed
+	bool HasGeneratedTexture() const { return GeneratedBillboardTexture.IsValid(); }
+	
+	// Still needs UpdateResource, UBangoScriptBillboardSubsystem uploads finished textures in batches
 	UTexture2D* GetGeneratedTexture() const;
 
 protected:
@@ -29,5 +33,13 @@ protected:
 	
 	bool bRunning = false;
 	
+	// See Bango::BillboardCache
+	FString CacheKey;
+	
+	// Looks for the billboard in the disk cache first, only generating it if that misses
 	void OnOverlayLoaded();
+	
+	void Generate(TStrongObjectPtr<UTexture2D> Result);
+	
+	void Finish(TStrongObjectPtr<UTexture2D> Result);
 };
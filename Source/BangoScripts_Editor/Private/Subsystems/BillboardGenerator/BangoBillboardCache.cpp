@@ -0,0 +1,215 @@
+﻿#include "BangoBillboardCache.h"
+
+#include "BangoScripts/EditorTooling/BangoDevSettings.h"
+#include "BangoScripts/EditorTooling/BangoScriptsEditorLog.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace Bango::BillboardCache
+{
+	// Bump whenever compositing changes what it outputs, old entries then simply stop being found and age out
+	constexpr uint32 CacheVersion = 1;
+	
+	constexpr uint32 EntryMagic = 0x42424243; // "BBBC"
+	
+	struct FEntryHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 SizeX;
+		int32 SizeY;
+	};
+	
+	FCriticalSection TrimLock;
+	
+	// Total size of the cache folder, INDEX_NONE until it's first scanned
+	int64 KnownCacheSize = INDEX_NONE;
+	
+	FString GetCacheDir()
+	{
+		return FPaths::ProjectIntermediateDir() / TEXT("BangoScripts") / TEXT("BillboardCache");
+	}
+	
+	FString GetEntryPath(const FString& Key)
+	{
+		return GetCacheDir() / Key + TEXT(".bin");
+	}
+	
+	// Deletes the least recently used entries until the cache fits its limit. Entries are touched on every load, so their timestamp is their last use.
+	// AddedSize is how much the cache grew since the last call, negative if it shrank.
+	void Trim(int64 AddedSize)
+	{
+		FScopeLock Lock(&TrimLock);
+		
+		const int64 SizeLimit = UBangoScriptsDeveloperSettings::GetBillboardCacheSizeLimit();
+		
+		// Only scan the folder once the running total says it's needed
+		if (KnownCacheSize != INDEX_NONE)
+		{
+			KnownCacheSize += AddedSize;
+			
+			if (KnownCacheSize <= SizeLimit)
+			{
+				return;
+			}
+		}
+		
+		struct FEntryFile
+		{
+			FString Path;
+			int64 Size;
+			FDateTime LastUsed;
+		};
+		
+		TArray<FEntryFile> Entries;
+		
+		IFileManager::Get().IterateDirectoryStat(*GetCacheDir(), [&Entries] (const TCHAR* Path, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory && FPaths::GetExtension(Path) == TEXT("bin"))
+			{
+				Entries.Add({ Path, StatData.FileSize, StatData.ModificationTime });
+			}
+			
+			return true;
+		});
+		
+		KnownCacheSize = 0;
+		
+		for (const FEntryFile& Entry : Entries)
+		{
+			KnownCacheSize += Entry.Size;
+		}
+		
+		if (KnownCacheSize <= SizeLimit)
+		{
+			return;
+		}
+		
+		Entries.Sort([] (const FEntryFile& A, const FEntryFile& B) { return A.LastUsed < B.LastUsed; });
+		
+		int32 NumEvicted = 0;
+		
+		for (const FEntryFile& Entry : Entries)
+		{
+			if (KnownCacheSize <= SizeLimit)
+			{
+				break;
+			}
+			
+			if (IFileManager::Get().Delete(*Entry.Path, false, false, true))
+			{
+				KnownCacheSize -= Entry.Size;
+				++NumEvicted;
+			}
+		}
+		
+		UE_LOG(LogBangoEditor, Verbose, TEXT("Evicted %i billboard cache entries, %lld bytes left"), NumEvicted, KnownCacheSize);
+	}
+}
+
+// ----------------------------------------------
+
+FString Bango::BillboardCache::MakeKey(const UTexture2D& Overlay, const FBlake3Hash& BaseHash)
+{
+	FBlake3 Hasher;
+	
+	Hasher.Update(&CacheVersion, sizeof(CacheVersion));
+	Hasher.Update(BaseHash.GetBytes(), sizeof(FBlake3Hash::ByteArray));
+	
+	const FString OverlayPath = Overlay.GetPathName();
+	Hasher.Update(*OverlayPath, OverlayPath.Len() * sizeof(TCHAR));
+	
+	// Changes whenever the overlay is reimported or edited
+	const FGuid SourceId = Overlay.Source.GetId();
+	Hasher.Update(&SourceId, sizeof(SourceId));
+	
+	const bool bSRGB = Overlay.SRGB;
+	Hasher.Update(&bSRGB, sizeof(bSRGB));
+	
+	return LexToString(Hasher.Finalize());
+}
+
+// ----------------------------------------------
+
+bool Bango::BillboardCache::Load(const FString& Key, const FIntPoint& Size, FColor* OutPixels)
+{
+	const FString Path = GetEntryPath(Key);
+	const int64 PixelsSize = int64(Size.X) * Size.Y * sizeof(FColor);
+	
+	TArray64<uint8> Data;
+	
+	if (!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+	
+	if (Data.Num() != sizeof(FEntryHeader) + PixelsSize)
+	{
+		return false;
+	}
+	
+	const FEntryHeader& Header = *reinterpret_cast<const FEntryHeader*>(Data.GetData());
+	
+	if (Header.Magic != EntryMagic || Header.Version != CacheVersion || Header.SizeX != Size.X || Header.SizeY != Size.Y)
+	{
+		return false;
+	}
+	
+	FMemory::Memcpy(OutPixels, Data.GetData() + sizeof(FEntryHeader), PixelsSize);
+	
+	IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow());
+	
+	return true;
+}
+
+// ----------------------------------------------
+
+void Bango::BillboardCache::Save(const FString& Key, const FIntPoint& Size, const FColor* Pixels)
+{
+	const FString Path = GetEntryPath(Key);
+	const int64 PixelsSize = int64(Size.X) * Size.Y * sizeof(FColor);
+	
+	FEntryHeader Header;
+	Header.Magic = EntryMagic;
+	Header.Version = CacheVersion;
+	Header.SizeX = Size.X;
+	Header.SizeY = Size.Y;
+	
+	TArray64<uint8> Data;
+	Data.SetNumUninitialized(sizeof(FEntryHeader) + PixelsSize);
+	
+	FMemory::Memcpy(Data.GetData(), &Header, sizeof(FEntryHeader));
+	FMemory::Memcpy(Data.GetData() + sizeof(FEntryHeader), Pixels, PixelsSize);
+	
+	// Written next to the entry and moved over it, so a concurrent Load never sees half a file
+	const FString TempPath = Path + TEXT(".tmp");
+	
+	if (!FFileHelper::SaveArrayToFile(Data, *TempPath))
+	{
+		UE_LOG(LogBangoEditor, Warning, TEXT("Could not write billboard cache entry %s"), *Path);
+		return;
+	}
+	
+	// Overwriting an entry only grows the cache by the difference. Measured together with the move, so that two saves of the same key can't both
+	// count the same replaced file.
+	int64 AddedSize = 0;
+	
+	{
+		FScopeLock Lock(&TrimLock);
+		
+		const int64 ReplacedSize = FMath::Max<int64>(IFileManager::Get().FileSize(*Path), 0);
+		
+		if (!IFileManager::Get().Move(*Path, *TempPath, true, true))
+		{
+			UE_LOG(LogBangoEditor, Warning, TEXT("Could not write billboard cache entry %s"), *Path);
+			return;
+		}
+		
+		AddedSize = Data.Num() - ReplacedSize;
+	}
+	
+	Trim(AddedSize);
+}
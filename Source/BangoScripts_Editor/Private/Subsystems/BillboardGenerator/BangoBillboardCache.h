@@ -0,0 +1,25 @@
+﻿#pragma once
+
+#include "Containers/UnrealString.h"
+#include "Hash/Blake3.h"
+#include "Math/Color.h"
+#include "Math/IntPoint.h"
+
+class UTexture2D;
+
+/**
+ * Generated script billboards are written to Intermediate/BangoScripts/BillboardCache, named by the hash of everything they were generated from, so that
+ * they don't need generating again in later sessions or after a map load. Least recently used entries are deleted once the folder passes
+ * UBangoScriptsDeveloperSettings::GetBillboardCacheSizeLimit().
+ */
+namespace Bango::BillboardCache
+{
+	// Hash of the overlay's path, source data and sRGB setting, the base sprite and the compositing version. Game thread only.
+	FString MakeKey(const UTexture2D& Overlay, const FBlake3Hash& BaseHash);
+	
+	// Reads an entry into OutPixels if there is one of this size, and marks it as recently used. Safe on any thread.
+	bool Load(const FString& Key, const FIntPoint& Size, FColor* OutPixels);
+	
+	// Writes an entry, then evicts the least recently used entries if the cache grew past its limit. Safe on any thread.
+	void Save(const FString& Key, const FIntPoint& Size, const FColor* Pixels);
+}
@@ -0,0 +1,306 @@
+﻿#include "BangoBillboardCompositor.h"
+
+#include "Async/ParallelFor.h"
+#include "BangoScripts/EditorTooling/BangoScriptsEditorLog.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Math/VectorRegister.h"
+
+namespace Bango::Billboard
+{
+	// "Over" blend of one straight alpha pixel, all four channels at once
+	FORCEINLINE void BlendOver(const FColor& Over, FColor& Under)
+	{
+		// Most overlay pixels are either empty or solid
+		if (Over.A == 0)
+		{
+			if (Under.A == 0)
+			{
+				Under = FColor(0, 0, 0, 0);
+			}
+			
+			return;
+		}
+		
+		if (Over.A == 255)
+		{
+			Under = Over;
+			return;
+		}
+		
+		const VectorRegister4Float Inv255 = VectorSetFloat1(1.0f / 255.0f);
+		
+		// Matches FLinearColor::ToFColor(false), which truncates after scaling by 255.999
+		const VectorRegister4Float StoreScale = VectorSetFloat1(255.999f / 255.0f);
+		
+		const VectorRegister4Float OverColor = VectorLoadByte4(&Over);
+		const VectorRegister4Float UnderColor = VectorLoadByte4(&Under);
+		
+		const VectorRegister4Float OverAlpha = VectorMultiply(VectorReplicate(OverColor, 3), Inv255);
+		const VectorRegister4Float UnderAlpha = VectorMultiply(VectorReplicate(UnderColor, 3), Inv255);
+		
+		// a1 * (1 - a2)
+		const VectorRegister4Float UnderWeight = VectorMultiply(UnderAlpha, VectorSubtract(GlobalVectorConstants::FloatOne, OverAlpha));
+		
+		// Can't be zero, Over.A isn't
+		const VectorRegister4Float OutAlpha = VectorAdd(OverAlpha, UnderWeight);
+		
+		VectorRegister4Float OutColor = VectorDivide(VectorMultiplyAdd(OverColor, OverAlpha, VectorMultiply(UnderColor, UnderWeight)), OutAlpha);
+		OutColor = VectorSelect(MakeVectorRegisterFloatMask(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0), OutColor, VectorMultiply(OutAlpha, VectorSetFloat1(255.0f)));
+		
+		VectorStoreByte4(VectorMultiply(OutColor, StoreScale), &Under);
+	}
+	
+	FAutoConsoleCommand BenchmarkCommand(
+		TEXT("Bango.Billboard.BenchmarkComposite"),
+		TEXT("Times billboard overlay compositing against the original per-pixel path on random images. Optional arguments: iterations (default 200), base size (default 256)."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([] (const TArray<FString>& Args)
+		{
+			const int32 Iterations = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 200);
+			const int32 Size = FMath::Max(16, Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 256);
+			
+			const FIntPoint BaseSize(Size, Size);
+			const FIntPoint DrawSize = GetOverlayDrawSize(BaseSize);
+			
+			TArray<FIntPoint> Offsets;
+			GetOverlayOffsets(BaseSize, Offsets);
+			
+			FRandomStream Random(1234);
+			
+			// Icons are mostly empty or solid with soft edges, so weigh alpha towards that
+			auto RandomAlpha = [&Random] ()
+			{
+				const float Roll = Random.FRand();
+				return Roll < 0.4f ? 0.0f : (Roll < 0.8f ? 1.0f : Random.FRand());
+			};
+			
+			TArray<FColor> Base;
+			Base.SetNumUninitialized(BaseSize.X * BaseSize.Y);
+			
+			for (FColor& Pixel : Base)
+			{
+				Pixel = FLinearColor(Random.FRand(), Random.FRand(), Random.FRand(), RandomAlpha()).ToFColor(false);
+			}
+			
+			UE::Geometry::TImageBuilder<FVector4f> Overlay;
+			Overlay.SetDimensions(UE::Geometry::FImageDimensions(128, 128));
+			
+			for (int32 Y = 0; Y < 128; ++Y)
+			{
+				for (int32 X = 0; X < 128; ++X)
+				{
+					Overlay.SetPixel(UE::Geometry::FVector2i(X, Y), FVector4f(Random.FRand(), Random.FRand(), Random.FRand(), RandomAlpha()));
+				}
+			}
+			
+			TArray<FColor> ReferenceResult;
+			TArray<FColor> Result;
+			TArray<FColor> Tile;
+			
+			double ReferenceTime = 0.0;
+			double Time = 0.0;
+			
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				ReferenceResult = Base;
+				
+				const double ReferenceStart = FPlatformTime::Seconds();
+				CompositeOverlay_Reference(ReferenceResult.GetData(), BaseSize, Overlay, true, DrawSize, Offsets);
+				ReferenceTime += FPlatformTime::Seconds() - ReferenceStart;
+				
+				Result = Base;
+				
+				// Resampling is part of the new path's cost
+				const double Start = FPlatformTime::Seconds();
+				ResampleOverlay(Overlay, true, DrawSize, Tile);
+				CompositeOverlay(Result.GetData(), BaseSize, Tile, DrawSize, Offsets);
+				Time += FPlatformTime::Seconds() - Start;
+			}
+			
+			int32 MaxDifference = 0;
+			
+			for (int32 i = 0; i < Result.Num(); ++i)
+			{
+				MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Result[i].R - ReferenceResult[i].R));
+				MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Result[i].G - ReferenceResult[i].G));
+				MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Result[i].B - ReferenceResult[i].B));
+				MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Result[i].A - ReferenceResult[i].A));
+			}
+			
+			const double ReferenceMs = 1000.0 * ReferenceTime / Iterations;
+			const double Ms = 1000.0 * Time / Iterations;
+			
+			UE_LOG(LogBangoEditor, Display, TEXT("Billboard composite %ix%i, %i iterations: reference %.4f ms, current %.4f ms (%.1fx), max channel difference %i"),
+				Size, Size, Iterations, ReferenceMs, Ms, Ms > 0.0 ? ReferenceMs / Ms : 0.0, MaxDifference);
+		}));
+}
+
+// ----------------------------------------------
+
+FIntPoint Bango::Billboard::GetOverlayDrawSize(const FIntPoint& BaseSize)
+{
+	return BaseSize / 4;
+}
+
+// ----------------------------------------------
+
+void Bango::Billboard::GetOverlayOffsets(const FIntPoint& BaseSize, TArray<FIntPoint>& OutOffsets)
+{
+	int32 OverlayHorizOffset = BaseSize.X * 1 / 4;
+	int32 OverlayVertOffset = BaseSize.Y * 1 / 4;
+	int32 OverlayPadding = 1; // We pad the top-right by a pixel to avoid border wrap issue
+	
+	// We need to apply overlay onto each quadrant.
+	OutOffsets = 
+	{
+		// Top-left overlay origin
+		{ 1 * OverlayHorizOffset - OverlayPadding, 0 * OverlayVertOffset + OverlayPadding },
+		
+		// Top-right overlay origin
+		{ 3 * OverlayHorizOffset - OverlayPadding, 0 * OverlayVertOffset + OverlayPadding },
+		
+		// Bottom-left overlay origin
+		{ 1 * OverlayHorizOffset - OverlayPadding, 2 * OverlayVertOffset + OverlayPadding },
+		
+		// Bottom-right overlay origin
+		{ 3 * OverlayHorizOffset - OverlayPadding, 2 * OverlayVertOffset + OverlayPadding },
+	};
+}
+
+// ----------------------------------------------
+
+void Bango::Billboard::DarkenBase(const FColor* BasePixels, FColor* ResultPixels, int32 NumPixels)
+{
+	// Same as scaling by 0.75 and truncating, but stays in integers
+	for (int32 i = 0; i < NumPixels; ++i)
+	{
+		const FColor& Base = BasePixels[i];
+		ResultPixels[i] = FColor(Base.R * 3 / 4, Base.G * 3 / 4, Base.B * 3 / 4, Base.A);
+	}
+}
+
+// ----------------------------------------------
+
+void Bango::Billboard::ResampleOverlay(const UE::Geometry::TImageBuilder<FVector4f>& Overlay, bool bOverlaySRGB, const FIntPoint& DrawSize, TArray<FColor>& OutTile)
+{
+	const int32 OverlayWidth = Overlay.GetDimensions().GetWidth();
+	const int32 OverlayHeight = Overlay.GetDimensions().GetHeight();
+	
+	OutTile.SetNumUninitialized(DrawSize.X * DrawSize.Y);
+	
+	for (int32 TileY = 0; TileY < DrawSize.Y; ++TileY)
+	{
+		const int32 OverlayY = FMath::Min(int32(float(TileY) / float(DrawSize.Y) * OverlayHeight), OverlayHeight - 1);
+		
+		for (int32 TileX = 0; TileX < DrawSize.X; ++TileX)
+		{
+			const int32 OverlayX = FMath::Min(int32(float(TileX) / float(DrawSize.X) * OverlayWidth), OverlayWidth - 1);
+			
+			// Auto-convert overlay texture to sRGB if needed (maybe I should not do this?)
+			OutTile[TileX + TileY * DrawSize.X] = FLinearColor(Overlay.GetPixel(OverlayX, OverlayY)).ToFColor(bOverlaySRGB);
+		}
+	}
+}
+
+// ----------------------------------------------
+
+void Bango::Billboard::CompositeOverlay(FColor* Pixels, const FIntPoint& PixelsSize, TConstArrayView<FColor> Tile, const FIntPoint& TileSize, TConstArrayView<FIntPoint> Offsets)
+{
+	check(Tile.Num() == TileSize.X * TileSize.Y);
+	
+	// One work item per tile row. Tiles don't overlap so no two rows write the same pixels.
+	const int32 NumRows = Offsets.Num() * TileSize.Y;
+	
+	ParallelFor(TEXT("BangoBillboardComposite"), NumRows, 16, [&] (int32 RowIndex)
+	{
+		const FIntPoint& Offset = Offsets[RowIndex / TileSize.Y];
+		const int32 TileY = RowIndex % TileSize.Y;
+		const int32 PixelY = Offset.Y + TileY;
+		
+		if (PixelY < 0 || PixelY >= PixelsSize.Y)
+		{
+			return;
+		}
+		
+		const int32 PixelXStart = FMath::Max(Offset.X, 0);
+		const int32 PixelXEnd = FMath::Min(Offset.X + TileSize.X, PixelsSize.X);
+		
+		const FColor* TileRow = Tile.GetData() + TileY * TileSize.X - Offset.X;
+		FColor* PixelRow = Pixels + PixelY * PixelsSize.X;
+		
+		for (int32 PixelX = PixelXStart; PixelX < PixelXEnd; ++PixelX)
+		{
+			BlendOver(TileRow[PixelX], PixelRow[PixelX]);
+		}
+	});
+}
+
+// ----------------------------------------------
+
+void Bango::Billboard::CompositeOverlay_Reference(FColor* ResultPixels, const FIntPoint& PixelsSize, const UE::Geometry::TImageBuilder<FVector4f>& OverlayParsedImage, bool bOverlaySRGB, const FIntPoint& DrawSize, TConstArrayView<FIntPoint> Offsets)
+{
+	int32 BaseWidth = PixelsSize.X;
+	
+	int32 OverlayTextureWidth = OverlayParsedImage.GetDimensions().GetWidth();
+	int32 OverlayTextureHeight = OverlayParsedImage.GetDimensions().GetHeight();
+	
+	for (FIntPoint BaseOffset : Offsets)
+	{
+		int32 OverlayXStart = BaseOffset.X;
+		int32 OverlayXEnd = BaseOffset.X + DrawSize.X;
+		int32 OverlayYStart = BaseOffset.Y;
+		int32 OverlayYEnd = BaseOffset.Y + DrawSize.Y;
+
+		for (int32 PixelY = OverlayYStart; PixelY < OverlayYEnd; ++PixelY)
+		{
+			for (int32 PixelX = 0; PixelX < OverlayXEnd; ++PixelX)
+			{
+				int32 PixelIndex = PixelX + PixelY * BaseWidth;
+			
+				// Transfer the base pixel coordinates into overlay texure coordinates
+				float OverlayXLerp = float(PixelX - OverlayXStart) / float(OverlayXEnd - OverlayXStart);
+				float OverlayYLerp = float(PixelY - OverlayYStart) / float(OverlayYEnd - OverlayYStart);
+			
+				if (OverlayXLerp < 0.0f || OverlayXLerp > 1.0f || OverlayYLerp < 0.0f || OverlayYLerp > 1.0f)
+				{
+					continue;
+				}
+				
+				int32 OverlayTexX = FMath::Clamp(OverlayXLerp * OverlayTextureWidth, 0, OverlayTextureWidth - 1);
+				int32 OverlayTexY = FMath::Clamp(OverlayYLerp * OverlayTextureHeight, 0, OverlayTextureHeight - 1);
+				
+				// Pixel 1 = base pixel
+				// Pixel 2 = overlay pixel
+				FVector4f P1 = ResultPixels[PixelIndex].ReinterpretAsLinear();
+				FVector4f P2 = OverlayParsedImage.GetPixel(OverlayTexX, OverlayTexY);
+
+				P2 = FLinearColor(FLinearColor(P2).ToFColor(bOverlaySRGB).ReinterpretAsLinear());
+				
+				float a2 = P2[3];
+				float a1 = P1[3];
+
+				float One = 1.0f;
+				
+				FVector3f C1(P1.X, P1.Y, P1.Z);
+				FVector3f C2(P2.X, P2.Y, P2.Z);
+
+				float ao = a2 + a1 * (One - a2);
+				FVector3f Co;
+				
+				if (ao < KINDA_SMALL_NUMBER)
+				{
+					Co = FVector4f(0.0f);
+				}
+				else
+				{
+					Co = (C2 * a2 + C1 * a1 * (One - a2)) / ao; 
+				}
+
+				FVector4f Cof(Co.X, Co.Y, Co.Z, ao);
+				
+				ResultPixels[PixelIndex] = FLinearColor(Cof).ToFColor(false);
+			}
+		}
+	}
+}
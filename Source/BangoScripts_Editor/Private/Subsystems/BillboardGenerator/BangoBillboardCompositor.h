@@ -0,0 +1,31 @@
+﻿#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Image/ImageBuilder.h"
+#include "Math/Color.h"
+#include "Math/IntPoint.h"
+
+/**
+ * Pixel work for generated script billboards. The base billboard is split into quadrants (one per billboard state) and the overlay is drawn into the
+ * top-right of each one.
+ */
+namespace Bango::Billboard
+{
+	// Size the overlay is drawn at in each quadrant
+	FIntPoint GetOverlayDrawSize(const FIntPoint& BaseSize);
+	
+	// Top-left corner of the overlay in each quadrant. The tiles never overlap.
+	void GetOverlayOffsets(const FIntPoint& BaseSize, TArray<FIntPoint>& OutOffsets);
+	
+	// Copies the base billboard into Result, darkened a bit so the overlay stands out
+	void DarkenBase(const FColor* BasePixels, FColor* ResultPixels, int32 NumPixels);
+	
+	// Point samples the overlay down to DrawSize and converts it to 8-bit once, instead of once per pixel per quadrant
+	void ResampleOverlay(const UE::Geometry::TImageBuilder<FVector4f>& Overlay, bool bOverlaySRGB, const FIntPoint& DrawSize, TArray<FColor>& OutTile);
+	
+	// Alpha blends Tile over Pixels at each offset. Only the tiles are visited; rows are spread over worker threads and each pixel is blended with vector math.
+	void CompositeOverlay(FColor* Pixels, const FIntPoint& PixelsSize, TConstArrayView<FColor> Tile, const FIntPoint& TileSize, TConstArrayView<FIntPoint> Offsets);
+	
+	// The original per-pixel FLinearColor blend. Only kept to compare against, see Bango.Billboard.BenchmarkComposite.
+	void CompositeOverlay_Reference(FColor* Pixels, const FIntPoint& PixelsSize, const UE::Geometry::TImageBuilder<FVector4f>& Overlay, bool bOverlaySRGB, const FIntPoint& DrawSize, TConstArrayView<FIntPoint> Offsets);
+}
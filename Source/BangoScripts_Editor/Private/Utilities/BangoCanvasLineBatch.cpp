@@ -0,0 +1,228 @@
+﻿#include "BangoCanvasLineBatch.h"
+
+#include "BatchedElements.h"
+#include "CanvasTypes.h"
+#include "Engine/Engine.h"
+#include "RenderUtils.h"
+#include "SceneView.h"
+#include "Utilities/BangoEditorUtility.h"
+
+// ----------------------------------------------
+
+FBangoCanvasLineBatch::FBangoCanvasLineBatch(const FSceneView& InView)
+	: View(InView)
+{
+	const FIntRect& ViewRect = View.UnscaledViewRect;
+	
+	CullRect = FBox2f(FVector2f(ViewRect.Min), FVector2f(ViewRect.Max));
+}
+
+// ----------------------------------------------
+
+void FBangoCanvasLineBatch::AddCircle_ScreenSpace(const FVector& ScreenPosition, float Radius, const FLinearColor& Color, int32 NumSides)
+{
+	if (ScreenPosition.Z <= 0.0f)
+	{
+		return;
+	}
+	
+	const FVector2f Center(ScreenPosition.X, ScreenPosition.Y);
+	
+	if (IsOutsideCullRect(Center, Center, Radius))
+	{
+		++NumCulled;
+		return;
+	}
+	
+	// Same color conversion as FCanvas::DrawNGon
+	Circles.Add( { Center, Radius, FLinearColor(Color.ToFColor(true)), FMath::Max(NumSides, 3) } );
+}
+
+// ----------------------------------------------
+
+void FBangoCanvasLineBatch::AddLine_ScreenSpace(const FVector2f& Start, const FVector2f& End, float Thickness, const FLinearColor& Color)
+{
+	if (Thickness <= KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+	
+	if (IsOutsideCullRect(Start, End, Thickness))
+	{
+		++NumCulled;
+		return;
+	}
+	
+	Lines.Add( { Start, End, Color, Thickness } );
+}
+
+// ----------------------------------------------
+
+void FBangoCanvasLineBatch::AddLine_WorldSpace(const FVector& WorldStart, const FVector& WorldEnd, float Thickness, const FLinearColor& Color, float StartCutoff, float EndCutoff, float DashLength)
+{
+	FVector Delta = WorldEnd - WorldStart;
+	if (Delta.SizeSquared() <= FMath::Square(StartCutoff + EndCutoff))
+	{
+		return;
+	}
+	
+	FVector LineDir = Delta.GetSafeNormal();
+	
+	FVector TrueStart = WorldStart + StartCutoff * LineDir;
+	FVector TrueEnd = WorldEnd - EndCutoff * LineDir;
+	
+	FPlane ClipPlane = View.NearClippingPlane;
+	
+	double StartDistance = FVector::PointPlaneDist(TrueStart, ClipPlane.GetOrigin(), ClipPlane.GetNormal());
+	double EndDistance = FVector::PointPlaneDist(TrueEnd, ClipPlane.GetOrigin(), ClipPlane.GetNormal());
+	
+	if (StartDistance >= 0.0f && EndDistance >= 0.0f)
+	{
+		return;
+	}
+	
+	if (StartDistance >= 0.0f)
+	{
+		TrueStart = ClipPlane.GetNormal() + FMath::LinePlaneIntersection(TrueStart, TrueEnd, ClipPlane.GetOrigin(), ClipPlane.GetNormal());
+	}
+
+	if (EndDistance >= 0.0f)
+	{
+		TrueEnd = ClipPlane.GetNormal() + FMath::LinePlaneIntersection(TrueStart, TrueEnd, ClipPlane.GetOrigin(), ClipPlane.GetNormal());
+	}
+	
+	// Once clipped to the near plane the line projects to a segment, so if both ends are off the same side of the screen every dash is too
+	FVector ScreenStart;
+	FVector ScreenEnd;
+	
+	if (!Bango::Editor::GetScreenPos(View, TrueStart, ScreenStart) || !Bango::Editor::GetScreenPos(View, TrueEnd, ScreenEnd))
+	{
+		return;
+	}
+	
+	if (IsOutsideCullRect(FVector2f(ScreenStart.X, ScreenStart.Y), FVector2f(ScreenEnd.X, ScreenEnd.Y), Thickness))
+	{
+		++NumCulled;
+		return;
+	}
+	
+	if (DashLength <= KINDA_SMALL_NUMBER)
+	{
+		AddLine_ScreenSpace(FVector2f(ScreenStart.X, ScreenStart.Y), FVector2f(ScreenEnd.X, ScreenEnd.Y), Thickness, Color);
+		return;
+	}
+	
+	int32 Segments = 1 + (TrueEnd - TrueStart).Length() / (DashLength);
+	
+	FRay Ray(TrueStart, TrueEnd - TrueStart);
+	
+	const FLinearColor GapColor = Color * 0.25f;
+	const float GapThickness = Thickness - 1.0f;
+	
+	FVector DashScreenStart = ScreenStart;
+	
+	for (int32 i = 0; i < Segments; ++i)
+	{
+		FVector DashStart = Ray.Origin + i * (DashLength) * Ray.Direction;
+		
+		const bool bLastDash = i >= Segments - 1;
+		FVector DashEnd = bLastDash ? TrueEnd : DashStart + DashLength * Ray.Direction;
+		
+		if ((DashEnd - DashStart).Dot(LineDir) <= 0.0f)
+		{
+			return;
+		}
+		
+		// Each dash starts where the previous one ended, so only the end needs projecting
+		FVector DashScreenEnd = ScreenEnd;
+		
+		if (!bLastDash && !Bango::Editor::GetScreenPos(View, DashEnd, DashScreenEnd))
+		{
+			return;
+		}
+		
+		const bool bGap = FMath::Modulo(i + 1, 2) == 0;
+		
+		AddLine_ScreenSpace(FVector2f(DashScreenStart.X, DashScreenStart.Y), FVector2f(DashScreenEnd.X, DashScreenEnd.Y), bGap ? GapThickness : Thickness, bGap ? GapColor : Color);
+		
+		DashScreenStart = DashScreenEnd;
+	}
+}
+
+// ----------------------------------------------
+
+void FBangoCanvasLineBatch::AddLabel_ScreenSpace(const FVector2f& Position, FString Text, const FLinearColor& Color)
+{
+	Labels.Add( { Position, MoveTemp(Text), Color } );
+}
+
+// ----------------------------------------------
+
+void FBangoCanvasLineBatch::Submit(FCanvas& Canvas)
+{
+	const FHitProxyId HitProxyId = Canvas.GetHitProxyId();
+	
+	if (!Circles.IsEmpty())
+	{
+		FBatchedElements* Triangles = Canvas.GetBatchedElements(FCanvas::ET_Triangle, nullptr, GWhiteTexture, SE_BLEND_Translucent);
+		
+		int32 NumVertices = 0;
+		
+		for (const FCircle& Circle : Circles)
+		{
+			NumVertices += Circle.NumSides + 1;
+		}
+		
+		Triangles->ReserveVertices(NumVertices);
+		
+		for (const FCircle& Circle : Circles)
+		{
+			const int32 CenterVertex = Triangles->AddVertexf(FVector4f(Circle.Center.X, Circle.Center.Y, 0.0f, 1.0f), FVector2f::ZeroVector, Circle.Color, HitProxyId);
+			const int32 FirstRimVertex = CenterVertex + 1;
+			
+			for (int32 Side = 0; Side < Circle.NumSides; ++Side)
+			{
+				float Sin, Cos;
+				FMath::SinCos(&Sin, &Cos, UE_TWO_PI * Side / Circle.NumSides);
+				
+				Triangles->AddVertexf(FVector4f(Circle.Center.X + Circle.Radius * Cos, Circle.Center.Y + Circle.Radius * Sin, 0.0f, 1.0f), FVector2f::ZeroVector, Circle.Color, HitProxyId);
+			}
+			
+			for (int32 Side = 0; Side < Circle.NumSides; ++Side)
+			{
+				Triangles->AddTriangle(CenterVertex, FirstRimVertex + Side, FirstRimVertex + (Side + 1) % Circle.NumSides, GWhiteTexture, SE_BLEND_Translucent);
+			}
+		}
+	}
+	
+	if (!Lines.IsEmpty())
+	{
+		FBatchedElements* LineElements = Canvas.GetBatchedElements(FCanvas::ET_Line);
+		
+		LineElements->ReserveLines(Lines.Num(), false, true);
+		
+		for (const FLine& Line : Lines)
+		{
+			LineElements->AddLine(FVector(Line.Start.X, Line.Start.Y, 0.0f), FVector(Line.End.X, Line.End.Y, 0.0f), Line.Color, HitProxyId, Line.Thickness);
+		}
+	}
+	
+	for (const FLabel& Label : Labels)
+	{
+		Canvas.DrawShadowedString(Label.Position.X, Label.Position.Y, *Label.Text, GEngine->GetSmallFont(), Label.Color);
+	}
+	
+	Circles.Reset();
+	Lines.Reset();
+	Labels.Reset();
+}
+
+// ----------------------------------------------
+
+bool FBangoCanvasLineBatch::IsOutsideCullRect(const FVector2f& Start, const FVector2f& End, float Margin) const
+{
+	return (Start.X < CullRect.Min.X - Margin && End.X < CullRect.Min.X - Margin)
+		|| (Start.X > CullRect.Max.X + Margin && End.X > CullRect.Max.X + Margin)
+		|| (Start.Y < CullRect.Min.Y - Margin && End.Y < CullRect.Min.Y - Margin)
+		|| (Start.Y > CullRect.Max.Y + Margin && End.Y > CullRect.Max.Y + Margin);
+}
@@ -0,0 +1,70 @@
+﻿#pragma once
+
+#include "Math/Box2D.h"
+
+class FCanvas;
+class FSceneView;
+
+/**
+ * Collects the lines, dashes, circles and text labels of a viewport visualization and submits them to the canvas in one go: all circles as one
+ * triangle batch, then all lines as one line batch, then the labels. Anything fully outside the view rect is culled as it is added, so it never
+ * reaches the canvas. Meant to be owned by whoever draws a whole view and submitted once per frame; each Submit adds its own batches.
+ */
+class FBangoCanvasLineBatch
+{
+public:
+	FBangoCanvasLineBatch(const FSceneView& InView);
+	
+	// ScreenPosition as returned by Bango::Editor::GetScreenPos, Z <= 0 is behind the camera
+	void AddCircle_ScreenSpace(const FVector& ScreenPosition, float Radius, const FLinearColor& Color, int32 NumSides = 16);
+	
+	void AddLine_ScreenSpace(const FVector2f& Start, const FVector2f& End, float Thickness, const FLinearColor& Color);
+	
+	// Clips to the near plane and splits into dashes of DashLength world units, every other dash dimmed and thinner (0 = solid)
+	void AddLine_WorldSpace(const FVector& WorldStart, const FVector& WorldEnd, float Thickness, const FLinearColor& Color, float StartCutoff = 0.0f, float EndCutoff = 0.0f, float DashLength = 0.0f);
+	
+	// Drawn after all lines, so text doesn't split up the line batch
+	void AddLabel_ScreenSpace(const FVector2f& Position, FString Text, const FLinearColor& Color);
+	
+	void Submit(FCanvas& Canvas);
+	
+	int32 GetNumCulled() const { return NumCulled; }
+	
+protected:
+	struct FLine
+	{
+		FVector2f Start;
+		FVector2f End;
+		FLinearColor Color;
+		float Thickness;
+	};
+	
+	struct FCircle
+	{
+		FVector2f Center;
+		float Radius;
+		FLinearColor Color;
+		int32 NumSides;
+	};
+	
+	struct FLabel
+	{
+		FVector2f Position;
+		FString Text;
+		FLinearColor Color;
+	};
+	
+	const FSceneView& View;
+	
+	FBox2f CullRect;
+	
+	TArray<FLine> Lines;
+	
+	TArray<FCircle> Circles;
+	
+	TArray<FLabel> Labels;
+	
+	int32 NumCulled = 0;
+	
+	bool IsOutsideCullRect(const FVector2f& Start, const FVector2f& End, float Margin) const;
+};
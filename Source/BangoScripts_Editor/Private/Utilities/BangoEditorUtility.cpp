@@ -7,6 +7,7 @@
 #include "BangoScripts/Core/BangoScriptContainer.h"
 #include "BangoScripts/EditorTooling/BangoColors.h"
 #include "BangoScripts/EditorTooling/BangoDebugUtility.h"
+#include "BangoScripts/EditorTooling/BangoDevSettings.h"
 #include "BangoScripts/Utility/BangoScriptsLog.h"
 #include "BangoScripts/EditorTooling/BangoScriptsEditorLog.h"
 #include "BangoScripts/Interfaces/BangoScriptContainerObjectInterface.h"
@@ -16,8 +17,11 @@
 #include "WorldPartition/WorldPartition.h"
 #include "EdGraph/EdGraph.h"
 #include "Engine/Canvas.h"
+#include "Engine/Engine.h"
 #include "Engine/GameViewportClient.h"
-#include "Unsorted/BangoActorNodeDraw.h"
+#include "LevelEditorViewport.h"
+#include "Subsystems/BangoActorConnectionsEditorSubsystem.h"
+#include "Utilities/BangoCanvasLineBatch.h"
 #include "Widgets/SViewport.h"
 #include "WorldPartition/WorldPartitionSubsystem.h"
 
@@ -301,172 +305,254 @@ void Bango::Editor::DebugDrawBlueprintToViewport(UCanvas* Canvas, APlayerControl
 		return;
 	}
 	
-	DebugDrawActorConnections(*Blueprint, *Canvas->SceneView, *Canvas->Canvas);
+	DebugDrawActorConnections(MakeArrayView(&Blueprint, 1), *Canvas->SceneView, *Canvas->Canvas);
 }
 
 // ----------------------------------------------
 
-void Bango::Editor::DebugDrawActorConnections(UBangoScriptBlueprint& ScriptBlueprint, const FSceneView& View,	FCanvas& Canvas)
+namespace Bango::ActorConnectionDraw
 {
-	const IBangoScriptHolderInterface* ScriptHolder = ScriptBlueprint.GetScriptHolder();
+	// Time spent drawing connections individually this frame, shared by every viewport and script
+	struct FFrameBudget
+	{
+		uint64 Frame = 0;
+		double SecondsUsed = 0.0;
+	};
+	
+	static FFrameBudget FrameBudget;
+}
+
+// ----------------------------------------------
+
+void Bango::Editor::DebugDrawActorConnections(TConstArrayView<UBangoScriptBlueprint*> ScriptBlueprints, const FSceneView& View, FCanvas& Canvas)
+{
+	using namespace Bango::ActorConnectionDraw;
+	
+	const float BaseRadius = 0.005 * View.UnscaledViewRect.Size().Y;
+	
+	const FBox2f ScreenRect(FVector2f(View.UnscaledViewRect.Min), FVector2f(View.UnscaledViewRect.Max));
+	const FVector ViewOrigin = View.ViewMatrices.GetViewOrigin();
 	
-	if (!ScriptHolder)
+	FIntPoint MousePosition(-1, -1);
+	
+	if (GCurrentLevelEditingViewportClient && GCurrentLevelEditingViewportClient->Viewport)
 	{
-		return;
+		GCurrentLevelEditingViewportClient->Viewport->GetMousePos(MousePosition);
 	}
 	
-	if (!ScriptBlueprint.GetOwnerActor().IsValid())
+	// -----------------
+	// Rank the connections of all scripts together, most relevant first
+	
+	struct FRankedConnection
 	{
-		return;
-	}
+		const FBangoActorConnection* Connection;
+		int32 OriginIndex;
+		FVector ScreenPos;
+		double DistanceSquared;
+		bool bFocused;
+		bool bHovered;
+		bool bSelected;
+		bool bOnScreen;
+	};
 	
-    if (const UBangoScript* Script = GetDefault<UBangoScript>(ScriptBlueprint.GeneratedClass))
-    {
-        if (Script->HideActorReferenceIndicators())
-        {
-            return;
-        }
-    }
-
-	AActor& OwnerActor = *ScriptBlueprint.GetOwnerActor().Get();
-
-	FName ScriptWPGridName = NAME_None;
+	// Where the connections of each script start from
+	TArray<FVector, TInlineAllocator<8>> Origins;
+	TArray<FRankedConnection> RankedConnections;
 	
-	auto GetWPGridCellName = [] (TSoftObjectPtr<AActor> ActorSoft) -> FName
+	for (UBangoScriptBlueprint* ScriptBlueprint : ScriptBlueprints)
 	{
-		if (AActor* Actor = ActorSoft.Get())
+		const IBangoScriptHolderInterface* ScriptHolder = ScriptBlueprint ? ScriptBlueprint->GetScriptHolder() : nullptr;
+		
+		if (!ScriptHolder || !ScriptBlueprint->GetOwnerActor().IsValid())
+		{
+			continue;
+		}
+		
+		if (const UBangoScript* Script = GetDefault<UBangoScript>(ScriptBlueprint->GeneratedClass))
 		{
-			if (UWorld* World = Actor->GetWorld())
+			if (Script->HideActorReferenceIndicators())
 			{
-				if (UWorldPartition* WorldPartition = World->GetWorldPartition())
-				{
-					UActorDescContainerInstance* ActorDescContainer = WorldPartition->GetActorDescContainerInstance();
+				continue;
+			}
+		}
 		
-					if (ActorDescContainer)
-					{
-						const FWorldPartitionActorDescInstance* ActorDesc = ActorDescContainer->GetActorDescInstanceByPath(FSoftObjectPath(Actor));
+		FBangoActorConnectionList* ConnectionList = UBangoActorConnectionsEditorSubsystem::GetConnections(*ScriptBlueprint);
+		
+		if (!ConnectionList)
+		{
+			continue;
+		}
+		
+		const AActor& OwnerActor = *ScriptBlueprint->GetOwnerActor().Get();
+		
+		const int32 OriginIndex = Origins.Add(OwnerActor.GetActorLocation() + ScriptHolder->GetDebugDrawOrigin());
+		
+		RankedConnections.Reserve(RankedConnections.Num() + ConnectionList->Connections.Num());
+		
+		for (FBangoActorConnection& Connection : ConnectionList->Connections)
+		{
+			if (!Connection.UpdatePosition())
+			{
+				continue;
+			}
+			
+			const AActor& Actor = *Connection.Target.Get();
 			
-						if (ActorDesc)
-						{
-							return ActorDesc->GetRuntimeGrid();
-						}
-					}
-				}
+			if (Actor.IsLockLocation())
+			{
+				continue;
 			}
+			
+			FRankedConnection& Ranked = RankedConnections.AddDefaulted_GetRef();
+			Ranked.Connection = &Connection;
+			Ranked.OriginIndex = OriginIndex;
+			Ranked.DistanceSquared = FVector::DistSquared(ViewOrigin, Connection.LastPosition);
+			Ranked.bFocused = Connection.IsFocused();
+			Ranked.bSelected = Actor.IsSelected();
+			Ranked.bOnScreen = GetScreenPos(View, Connection.LastPosition, Ranked.ScreenPos) && Ranked.ScreenPos.Z > 0.0f && ScreenRect.IsInside(FVector2f(Ranked.ScreenPos.X, Ranked.ScreenPos.Y));
+			Ranked.bHovered = Ranked.bOnScreen && FVector2f::DistSquared(FVector2f(Ranked.ScreenPos.X, Ranked.ScreenPos.Y), FVector2f(MousePosition)) <= FMath::Square(2.0f * BaseRadius + 4.0f);
 		}
+	}
+	
+	if (RankedConnections.IsEmpty())
+	{
+		return;
+	}
+	
+	RankedConnections.Sort( [] (const FRankedConnection& A, const FRankedConnection& B)
+	{
+		if (A.bFocused != B.bFocused)	return A.bFocused;
+		if (A.bHovered != B.bHovered)	return A.bHovered;
+		if (A.bSelected != B.bSelected)	return A.bSelected;
+		if (A.bOnScreen != B.bOnScreen)	return A.bOnScreen;
 		
-		return NAME_None;
-	};
+		return A.DistanceSquared < B.DistanceSquared;
+	});
 	
-	ScriptWPGridName = GetWPGridCellName(ScriptBlueprint.GetOwnerActor());
+	// -----------------
+	// Draw the top ones individually, within the count budget of this view and the time budget of this frame
 	
-	FVector DrawOrigin = OwnerActor.GetActorLocation() + ScriptHolder->GetDebugDrawOrigin();
+	if (FrameBudget.Frame != GFrameCounter)
+	{
+		FrameBudget.Frame = GFrameCounter;
+		FrameBudget.SecondsUsed = 0.0;
+	}
 	
-	TArray<UEdGraph*> Graphs;
-	ScriptBlueprint.GetAllGraphs(Graphs);
-
-	for (const UEdGraph* Graph : Graphs)
+	const int32 MaxDrawnConnections = UBangoScriptsDeveloperSettings::GetMaxDrawnActorConnections();
+	const double DrawBudgetSeconds = UBangoScriptsDeveloperSettings::GetActorConnectionDrawBudgetSeconds() - FrameBudget.SecondsUsed;
+	const double DrawStartTime = FPlatformTime::Seconds();
+	
+	const float StartDrawDistance = 30.0f;
+	
+	FBangoCanvasLineBatch Batch(View);
+	
+	int32 NumDrawn = 0;
+	
+	for (; NumDrawn < RankedConnections.Num() && NumDrawn < MaxDrawnConnections; ++NumDrawn)
 	{
-		// TODO can I check for focus?
+		// Checking the clock every few connections is plenty. An earlier view that used up the frame's budget still gets its first few drawn.
+		if (NumDrawn % 8 == 7 && FPlatformTime::Seconds() - DrawStartTime > DrawBudgetSeconds)
+		{
+			break;
+		}
 		
-		TArray<UK2Node_BangoFindActor*> AllFindActorNodes;
-		Graph->GetNodesOfClass(AllFindActorNodes);
-
-		TSet<FBangoActorNodeDraw> UniqueFindActorNodes;
-
-		// TODO this should be a cvar/ini setting
-		const int32 MaxActorVisualizationCount = 100;
+		const FRankedConnection& Ranked = RankedConnections[NumDrawn];
+		const FBangoActorConnection& Connection = *Ranked.Connection;
+		const FVector& DrawOrigin = Origins[Ranked.OriginIndex];
+		
+		const bool bFocused = Ranked.bFocused || Ranked.bHovered;
+		
+		float Saturation = bFocused ? 1.0f : 0.6f;
+		float Luminosity = bFocused ? 1.0f : 0.6f;
+		float Thickness = bFocused ? 3.0f : 1.0f;
+		float Radius = bFocused ? 2.0f * BaseRadius : BaseRadius; 
+		FLinearColor Color = Bango::Colors::Funcs::GetHashedColor(GetTypeHash(Connection.Target), Saturation, Luminosity);
 		
-		// This is kind of arbitrary but if some nutjob builds a script with 1000000 actor nodes I don't want to choke the system to a crawl.
-		if (AllFindActorNodes.Num() <= MaxActorVisualizationCount)
+		// Draw circle
+		if (Ranked.bOnScreen)
 		{
-			UniqueFindActorNodes.Reserve(AllFindActorNodes.Num());
-			
-			// First we iterate over the whole list to find all actors to draw
-			for (const UK2Node_BangoFindActor* Node : AllFindActorNodes)
-			{
-				const TSoftObjectPtr<AActor> TargetActor = Node->GetTargetActor();
-			
-				if (ScriptWPGridName != NAME_None)
-				{
-					FName ThisActorWPGridName = GetWPGridCellName(TargetActor);
-					
-					UE_LOG(LogTemp, Warning, TEXT("%s --- %s"), *ScriptWPGridName.ToString(), *ThisActorWPGridName.ToString());
-				}
-				
-				if (const AActor* Actor = TargetActor.Get())
-				{
-					if (Actor->IsLockLocation())
-					{
-						continue;
-					}
-					
-					FBangoActorNodeDraw DrawRecord;
-					DrawRecord.Actor = TargetActor;
-					
-					bool bAlreadyInSet;
-					FBangoActorNodeDraw& Draw = UniqueFindActorNodes.FindOrAddByHash(GetTypeHash(Actor), DrawRecord, &bAlreadyInSet);
-					Draw.bFocused = Draw.bFocused || (GFrameCounter - Node->LastSelectedFrame < 3);
-				}
-			}
-			
-			const float BaseRadius = 0.005 * View.UnscaledViewRect.Size().Y;
+			Batch.AddCircle_ScreenSpace(Ranked.ScreenPos, Radius, Color);
+		}
 
-			// Now we draw
-			for (const FBangoActorNodeDraw& ActorNode : UniqueFindActorNodes)
-			{
-				if (!ActorNode.Actor.IsValid())
-				{
-					continue;
-				}
-				
-				const AActor& Actor = *ActorNode.Actor.Get();
-				
-				float Saturation = ActorNode.bFocused ? 1.0f : 0.6f;
-				float Luminosity = ActorNode.bFocused ? 1.0f : 0.6f;
-				float Thickness = ActorNode.bFocused ? 3.0f : 1.0f;
-				float Radius = ActorNode.bFocused ? 2.0f * BaseRadius : BaseRadius; 
-				FLinearColor Color = Bango::Colors::Funcs::GetHashedColor(GetTypeHash(ActorNode.Actor), Saturation, Luminosity);
-				
-				// Draw circle
-				FVector TargetActorWorldPos;
-				FVector TargetActorScreenPos;
-				if (!GetActorScreenPos(View, Actor, TargetActorWorldPos, TargetActorScreenPos))
-				{
-					return;
-				}
-								
-				DrawCircle_ScreenSpace(View, Canvas, TargetActorScreenPos, Radius, Thickness, Color);					
-
-				// Draw connection line
-				FVector Delta = ActorNode.Actor->GetActorLocation() - DrawOrigin;
-				
-				const float StartDrawDistance = 30.0f;
-				
-				if (Delta.SizeSquared() > FMath::Square(StartDrawDistance))
-				{
-					FVector Start = DrawOrigin;
-					FVector End = TargetActorWorldPos;
+		// Draw connection line
+		FVector Delta = Connection.LastActorLocation - DrawOrigin;
+		
+		if (Delta.SizeSquared() > FMath::Square(StartDrawDistance))
+		{
+			const float DashLength = Connection.bHardRef ? 0.0f : 150.0f;
 			
-					float DashLength = 0.0f;
-					
-					if (const IBangoScriptHolderInterface* Interface = ScriptBlueprint.GetScriptHolder())
-					{
-						if (!Interface->GetScriptContainer().HardActorRefs.Contains(&Actor))
-						{
-							DashLength = 150.0f;
-						}
-					}
-					
-					Bango::Editor::DrawLine_WorldSpace(View, Canvas, Start, End, Thickness, Color, StartDrawDistance, 0.0f, DashLength);
-				}
-			}
+			Batch.AddLine_WorldSpace(DrawOrigin, Connection.LastPosition, Thickness, Color, StartDrawDistance, 0.0f, DashLength);
 		}
-		else
+	}
+	
+	FrameBudget.SecondsUsed += FPlatformTime::Seconds() - DrawStartTime;
+	
+	// -----------------
+	// Merge the rest into one summary marker per screen area, with one line to it per script
+	
+	struct FConnectionCluster
+	{
+		FVector2f ScreenSum = FVector2f::ZeroVector;
+		int32 Count = 0;
+	};
+	
+	struct FClusterLine
+	{
+		FVector WorldSum = FVector::ZeroVector;
+		int32 Count = 0;
+	};
+	
+	TMap<FIntPoint, FConnectionCluster> Clusters;
+	TMap<TPair<int32, FIntPoint>, FClusterLine> ClusterLines;
+	
+	const float ClusterSize = UBangoScriptsDeveloperSettings::GetActorConnectionClusterSize();
+	
+	for (int32 i = NumDrawn; i < RankedConnections.Num(); ++i)
+	{
+		const FRankedConnection& Ranked = RankedConnections[i];
+		
+		// Behind the camera, there's no sensible spot on screen to merge it into
+		if (Ranked.ScreenPos.Z <= 0.0f)
 		{
-			// TODO fast path - just display count stuff
+			continue;
 		}
+		
+		// Off-screen ones are merged at the screen edge
+		const FVector2f ClampedScreenPos(FMath::Clamp<float>(Ranked.ScreenPos.X, ScreenRect.Min.X, ScreenRect.Max.X), FMath::Clamp<float>(Ranked.ScreenPos.Y, ScreenRect.Min.Y, ScreenRect.Max.Y));
+		const FIntPoint Cell(FMath::FloorToInt(ClampedScreenPos.X / ClusterSize), FMath::FloorToInt(ClampedScreenPos.Y / ClusterSize));
+		
+		FConnectionCluster& Cluster = Clusters.FindOrAdd(Cell);
+		Cluster.ScreenSum += ClampedScreenPos;
+		++Cluster.Count;
+		
+		FClusterLine& ClusterLine = ClusterLines.FindOrAdd( { Ranked.OriginIndex, Cell } );
+		ClusterLine.WorldSum += Ranked.Connection->LastPosition;
+		++ClusterLine.Count;
+	}
+	
+	const FLinearColor ClusterColor(0.5f, 0.5f, 0.5f, 0.8f);
+	
+	for (const TPair<TPair<int32, FIntPoint>, FClusterLine>& Pair : ClusterLines)
+	{
+		const FClusterLine& ClusterLine = Pair.Value;
+		
+		const FVector WorldCenter = ClusterLine.WorldSum / ClusterLine.Count;
+		const float Thickness = 1.0f + FMath::Log2(static_cast<float>(ClusterLine.Count));
+		
+		Batch.AddLine_WorldSpace(Origins[Pair.Key.Key], WorldCenter, Thickness, ClusterColor, StartDrawDistance);
 	}
+	
+	for (const TPair<FIntPoint, FConnectionCluster>& Pair : Clusters)
+	{
+		const FConnectionCluster& Cluster = Pair.Value;
+		
+		const FVector2f ScreenCenter = Cluster.ScreenSum / Cluster.Count;
+		
+		Batch.AddCircle_ScreenSpace(FVector(ScreenCenter.X, ScreenCenter.Y, 1.0f), 1.5f * BaseRadius, ClusterColor);
+		Batch.AddLabel_ScreenSpace(ScreenCenter + FVector2f(1.5f * BaseRadius, -1.5f * BaseRadius), FString::Printf(TEXT("%i"), Cluster.Count), FLinearColor::White);
+	}
+	
+	Batch.Submit(Canvas);
 }
 
 // ----------------------------------------------
@@ -515,109 +601,18 @@ bool Bango::Editor::GetActorScreenPos(const UCanvas& Canvas, const AActor& Actor
 
 void Bango::Editor::DrawCircle_ScreenSpace(const FSceneView& View, FCanvas& Canvas, const FVector& ScreenPosition, float Radius, float Thickness, const FLinearColor& Color)
 {
-	if (ScreenPosition.Z <= 0.0f)
-	{
-		return;
-	}
-	
-	Canvas.DrawNGon(FVector2D(ScreenPosition.X, ScreenPosition.Y), Color.ToFColor(true), 16, Radius);
+	FBangoCanvasLineBatch Batch(View);
+	Batch.AddCircle_ScreenSpace(ScreenPosition, Radius, Color);
+	Batch.Submit(Canvas);
 }
 
 // ----------------------------------------------
 
 void Bango::Editor::DrawLine_WorldSpace(const FSceneView& View, FCanvas& Canvas, const FVector& WorldStart,	const FVector& WorldEnd, float Thickness, const FLinearColor& Color, float StartCutoff, float EndCutoff, float DashLength)
 {
-	FVector Delta = WorldEnd - WorldStart;
-	if (Delta.SizeSquared() <= FMath::Square(StartCutoff + EndCutoff))
-	{
-		return;
-	}
-	
-	FVector LineDir = (WorldEnd - WorldStart).GetSafeNormal();
-	
-	FVector TrueStart = WorldStart + StartCutoff * LineDir;
-	FVector TrueEnd = WorldEnd - EndCutoff * LineDir;
-	
-	FPlane ClipPlane = View.NearClippingPlane;
-	
-	double StartDistance = FVector::PointPlaneDist(TrueStart, ClipPlane.GetOrigin(), ClipPlane.GetNormal());
-	double EndDistance = FVector::PointPlaneDist(TrueEnd, ClipPlane.GetOrigin(), ClipPlane.GetNormal());
-	
-	if (StartDistance >= 0.0f && EndDistance >= 0.0f)
-	{
-		return;
-	}
-	
-	if (StartDistance >= 0.0f)
-	{
-		TrueStart = ClipPlane.GetNormal() + FMath::LinePlaneIntersection(TrueStart, TrueEnd, ClipPlane.GetOrigin(), ClipPlane.GetNormal());
-	}
-
-	if (EndDistance >= 0.0f)
-	{
-		TrueEnd = ClipPlane.GetNormal() + FMath::LinePlaneIntersection(TrueStart, TrueEnd, ClipPlane.GetOrigin(), ClipPlane.GetNormal());
-	}
-	
-	if (DashLength <= KINDA_SMALL_NUMBER)
-	{
-		DashLength = 999999999.0f;
-	}
-	
-	int32 Segments = 1 + (TrueEnd - TrueStart).Length() / (DashLength);
-	
-	FRay Ray(TrueStart, TrueEnd - TrueStart);
-	
-	for (int32 i = 0; i < Segments; ++i)
-	{
-		FVector DashStart = Ray.Origin + i * (DashLength) * Ray.Direction;
-
-		FVector DashEnd;
-
-		if (i >= Segments - 1)
-		{
-			DashEnd = TrueEnd;
-		}
-		else
-		{
-			DashEnd = DashStart + DashLength * Ray.Direction;
-		}
-
-		FVector ScreenStart;
-		FVector ScreenEnd;
-	
-		if (!GetScreenPos(View, DashStart, ScreenStart))
-		{
-			return;
-		}
-
-		if (!GetScreenPos(View, DashEnd, ScreenEnd))
-		{
-			return;
-		}
-
-		if ((DashEnd - DashStart).Dot(LineDir) <= 0.0f)
-		{
-			return;
-		}
-	 
-		FCanvasLineItem Line(FVector2D(ScreenStart.X, ScreenStart.Y), FVector2D(ScreenEnd.X, ScreenEnd.Y));
-	
-		FLinearColor DashColor = Color;
-		float DashThickness = Thickness;
-		
-		if (FMath::Modulo(i+1, 2) == 0)
-		{
-			DashColor = Color * 0.25f;
-			DashThickness = Thickness - 1.0f;
-		}
-		
-		if (DashThickness > KINDA_SMALL_NUMBER)
-		{
-			Line.LineThickness = DashThickness;
-			Line.SetColor(DashColor);
-			Canvas.DrawItem(Line);
-		}
-	}
+	FBangoCanvasLineBatch Batch(View);
+	Batch.AddLine_WorldSpace(WorldStart, WorldEnd, Thickness, Color, StartCutoff, EndCutoff, DashLength);
+	Batch.Submit(Canvas);
 }
 
 // ----------------------------------------------
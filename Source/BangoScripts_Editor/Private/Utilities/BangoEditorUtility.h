@@ -59,8 +59,9 @@ namespace Bango::Editor
 	//
 	void DebugDrawBlueprintToViewport(UCanvas* Canvas, APlayerController* ALWAYS_NULL, FBangoScriptBlueprintEditor* ScriptBlueprintEditor);
 	
-	//
-	void DebugDrawActorConnections(UBangoScriptBlueprint& ScriptBlueprint, const FSceneView& View, FCanvas& Canvas);
+	// Ranks the actor connections of all given scripts together, draws the most relevant ones within the draw budgets and merges the rest. Everything
+	// goes into one batch that is submitted once.
+	void DebugDrawActorConnections(TConstArrayView<UBangoScriptBlueprint*> ScriptBlueprints, const FSceneView& View, FCanvas& Canvas);
 	
 	// Varints for UDebugDrawService
 	void DrawCircle_ScreenSpace(UCanvas& Canvas, const FVector& ScreenPosition, float Radius, float Thickness, const FLinearColor& Color);
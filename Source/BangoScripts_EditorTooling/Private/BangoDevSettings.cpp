@@ -69,3 +69,68 @@ float UBangoScriptsDeveloperSettings::GetPIEDisplayDistance()
 		
 	return -1.0f;
 }
+
+int32 UBangoScriptsDeveloperSettings::GetMaxDrawnActorConnections()
+{
+	return FMath::Max(1, Get().MaxDrawnActorConnections);
+}
+
+double UBangoScriptsDeveloperSettings::GetActorConnectionDrawBudgetSeconds()
+{
+	return FMath::Max(0.0f, Get().ActorConnectionDrawBudget) / 1000.0;
+}
+
+int32 UBangoScriptsDeveloperSettings::GetActorConnectionClusterSize()
+{
+	return FMath::Max(8, Get().ActorConnectionClusterSize);
+}
+
+float UBangoScriptsDeveloperSettings::GetNearbyScriptQueryExtent()
+{
+	return FMath::Max(100.0f, Get().NearbyScriptQueryExtent);
+}
+
+float UBangoScriptsDeveloperSettings::GetNearbyScriptUpdateInterval()
+{
+	return 1.0f / FMath::Max(1.0f, Get().NearbyScriptUpdateRate);
+}
+
+float UBangoScriptsDeveloperSettings::GetNearbyScriptCameraMoveThreshold()
+{
+	return FMath::Max(0.0f, Get().NearbyScriptCameraMoveThreshold);
+}
+
+float UBangoScriptsDeveloperSettings::GetNearbyScriptCameraRotateThreshold()
+{
+	return FMath::Max(0.0f, Get().NearbyScriptCameraRotateThreshold);
+}
+
+double UBangoScriptsDeveloperSettings::GetNearbyScriptMaxQueryAge()
+{
+	return FMath::Max(0.1f, Get().NearbyScriptMaxQueryAge);
+}
+
+float UBangoScriptsDeveloperSettings::GetScriptIconDetailDistance()
+{
+	return FMath::Max(100.0f, Get().ScriptIconDetailDistance);
+}
+
+int32 UBangoScriptsDeveloperSettings::GetScriptIconClusterSize()
+{
+	return FMath::Max(8, Get().ScriptIconClusterSize);
+}
+
+int32 UBangoScriptsDeveloperSettings::GetMaxConcurrentBillboardGenerators()
+{
+	return FMath::Max(1, Get().MaxConcurrentBillboardGenerators);
+}
+
+int32 UBangoScriptsDeveloperSettings::GetBillboardUploadsPerFrame()
+{
+	return FMath::Max(1, Get().BillboardUploadsPerFrame);
+}
+
+int64 UBangoScriptsDeveloperSettings::GetBillboardCacheSizeLimit()
+{
+	return int64(FMath::Max(1, Get().BillboardCacheSizeLimit)) * 1024 * 1024;
+}
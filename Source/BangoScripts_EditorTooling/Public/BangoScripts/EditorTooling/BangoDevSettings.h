@@ -38,11 +38,93 @@ protected:
 	/** Past this distance, any debug labels will be strongly faded or invisible. Unset this to always render, e.g. for isometric views. */
 	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 0.0, ClampMax = 100000.0, UIMin = 0.0, UIMax = 50000.0))
 	TOptional<float> ScriptIconPIEDisplayDistance = 10000;
+	
+	// ------------------------------------------
+	// Viewport visualization
+protected:
+	/** Most actor connections drawn individually per viewport per frame, across all scripts being drawn. Connections are ranked by node selection, mouse hover, level selection, being on screen and distance; the rest are merged into one summary line per screen area. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 1, UIMin = 1, UIMax = 500))
+	int32 MaxDrawnActorConnections = 64;
+	
+	/** Time all actor connections may take to draw per frame, shared by every script and viewport. Once used up, the remaining connections are merged into summary lines. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 0.0, UIMax = 5.0, Units = "ms"))
+	float ActorConnectionDrawBudget = 0.5f;
+	
+	/** Size in pixels of the screen areas that connections which weren't drawn individually are merged by. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 8, UIMax = 512))
+	int32 ActorConnectionClusterSize = 96;
+	
+	/** Half size of the box around the camera that script icons and hover controls are gathered from. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 100.0, UIMax = 50000.0, Units = "cm"))
+	float NearbyScriptQueryExtent = 5000.0f;
+	
+	/** How often per second the nearby scripts may be gathered again while the camera moves or scripts are added, removed or moved. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 1.0, UIMax = 60.0))
+	float NearbyScriptUpdateRate = 10.0f;
+	
+	/** How far the camera has to move before the nearby scripts are gathered again. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 0.0, UIMax = 1000.0, Units = "cm"))
+	float NearbyScriptCameraMoveThreshold = 50.0f;
+	
+	/** How far the camera has to turn before the nearby scripts are gathered again. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 0.0, UIMax = 45.0, Units = "deg"))
+	float NearbyScriptCameraRotateThreshold = 2.0f;
+	
+	/** Longest the nearby scripts go without being gathered again, even if nothing moved. Picks up billboard and script changes that don't move anything. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 0.1, UIMax = 10.0, Units = "s"))
+	float NearbyScriptMaxQueryAge = 1.0f;
+	
+	/** Past this distance script icons lose their hover menu and label, and icons that overlap on screen are merged into one icon with a count badge. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 100.0, UIMax = 50000.0, Units = "cm"))
+	float ScriptIconDetailDistance = 2500.0f;
+	
+	/** Size in pixels of the screen areas that far script icons are merged by. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 8, UIMax = 512))
+	int32 ScriptIconClusterSize = 48;
+	
+	/** Most custom script billboards generated at the same time. Billboards of scripts in view are generated first. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 1, UIMin = 1, UIMax = 16))
+	int32 MaxConcurrentBillboardGenerators = 4;
+	
+	/** Most generated billboard textures uploaded to the GPU per editor frame. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 1, UIMin = 1, UIMax = 128))
+	int32 BillboardUploadsPerFrame = 16;
+	
+	/** Size of the on-disk cache of generated billboards in Intermediate/BangoScripts/BillboardCache. The least recently used ones are deleted past this. */
+	UPROPERTY(Config, EditAnywhere, Category = "Bango", meta = (ClampMin = 1, UIMax = 1024, Units = "MB"))
+	int32 BillboardCacheSizeLimit = 64;
 
 public:
 	static bool GetPreventSlateThrottlingOverrides();
 	
 	static float GetPIEDisplayDistance();
+	
+	static int32 GetMaxDrawnActorConnections();
+	
+	static double GetActorConnectionDrawBudgetSeconds();
+	
+	static int32 GetActorConnectionClusterSize();
+	
+	static float GetNearbyScriptQueryExtent();
+	
+	static float GetNearbyScriptUpdateInterval();
+	
+	static float GetNearbyScriptCameraMoveThreshold();
+	
+	static float GetNearbyScriptCameraRotateThreshold();
+	
+	static double GetNearbyScriptMaxQueryAge();
+	
+	static float GetScriptIconDetailDistance();
+	
+	static int32 GetScriptIconClusterSize();
+	
+	static int32 GetMaxConcurrentBillboardGenerators();
+	
+	static int32 GetBillboardUploadsPerFrame();
+	
+	// In bytes
+	static int64 GetBillboardCacheSizeLimit();
 
 	// void OnCvarChange();
 };
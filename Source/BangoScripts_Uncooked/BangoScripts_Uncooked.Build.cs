@@ -33,6 +33,7 @@ public class BangoScripts_Uncooked : ModuleRules
                 "Kismet",
                 "EditorSubsystem",
                 "GraphEditor",
+                "AssetRegistry",
             }
         );
         
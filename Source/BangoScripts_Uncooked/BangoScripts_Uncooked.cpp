@@ -1,10 +1,13 @@
 ﻿#include "BangoScripts_Uncooked.h"
 
+#include "BangoScripts/Core/BangoScriptBlueprint.h"
+#include "Compiler/BangoScriptCompilerContext.h"
+
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
 void FBangoScripts_UncookedModule::StartupModule()
 {
-
+	FKismetCompilerContext::RegisterCompilerForBP(UBangoScriptBlueprint::StaticClass(), &FBangoScriptCompilerContext::MakeCompiler);
 }
 
 void FBangoScripts_UncookedModule::ShutdownModule()
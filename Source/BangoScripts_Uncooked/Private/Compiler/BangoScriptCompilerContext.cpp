@@ -0,0 +1,412 @@
+﻿#include "BangoScriptCompilerContext.h"
+
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_DynamicCast.h"
+#include "BangoScripts/Core/BangoScript.h"
+#include "BangoScripts/EditorTooling/BangoScriptsEditorLog.h"
+#include "BangoScripts/Uncooked/K2Nodes/K2Node_BangoThis.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Subsystems/BangoExpansionStatsSubsystem.h"
+
+static TAutoConsoleVariable<int32> CVarBangoOptimizeScripts(
+	TEXT("Bango.Cook.OptimizeScripts"),
+	0,
+	TEXT("Runs the Bango peephole pass after node expansion when compiling Bango scripts. 0 = off, 1 = only while cooking, 2 = always."));
+
+namespace Bango::Peephole
+{
+	TOptional<bool> PassOverride;
+}
+
+// ----------------------------------------------
+
+FBangoScriptCompilerContext::FBangoScriptCompilerContext(UBlueprint* InBlueprint, FCompilerResultsLog& InMessageLog, const FKismetCompilerOptions& InCompilerOptions)
+	: FKismetCompilerContext(InBlueprint, InMessageLog, InCompilerOptions)
+{
+}
+
+// ----------------------------------------------
+
+TSharedPtr<FKismetCompilerContext> FBangoScriptCompilerContext::MakeCompiler(UBlueprint* InBlueprint, FCompilerResultsLog& InMessageLog, const FKismetCompilerOptions& InCompilerOptions)
+{
+	return MakeShared<FBangoScriptCompilerContext>(InBlueprint, InMessageLog, InCompilerOptions);
+}
+
+// ----------------------------------------------
+
+bool FBangoScriptCompilerContext::IsPeepholePassEnabled()
+{
+	if (Bango::Peephole::PassOverride.IsSet())
+	{
+		return Bango::Peephole::PassOverride.GetValue();
+	}
+	
+	switch (CVarBangoOptimizeScripts.GetValueOnGameThread())
+	{
+		case 1:		return IsRunningCookCommandlet();
+		case 2:		return true;
+		default:	return false;
+	}
+}
+
+// ----------------------------------------------
+
+void FBangoScriptCompilerContext::SetPeepholePassOverride(TOptional<bool> bEnabled)
+{
+	Bango::Peephole::PassOverride = bEnabled;
+}
+
+// ----------------------------------------------
+
+void FBangoScriptCompilerContext::CreateClassVariablesFromBlueprint()
+{
+	FKismetCompilerContext::CreateClassVariablesFromBlueprint();
+	
+	TArray<UK2Node_BangoThis*> ThisNodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, ThisNodes);
+	
+	TSet<UClass*> OutputClasses;
+	
+	for (const UK2Node_BangoThis* ThisNode : ThisNodes)
+	{
+		OutputClasses.Add(ThisNode->GetOutputClass());
+	}
+	
+	TypedThisProperties.Reset(OutputClasses.Num());
+	
+	for (UClass* OutputClass : OutputClasses)
+	{
+		const FName PropertyName = UK2Node_BangoThis::GetTypedThisPropertyName(OutputClass);
+		
+		FEdGraphPinType PinType;
+		PinType.PinCategory = UEdGraphSchema_K2::PC_Object;
+		PinType.PinSubCategoryObject = OutputClass;
+		
+		FProperty* Property = CreateVariable(PropertyName, PinType);
+		
+		if (!Property)
+		{
+			MessageLog.Error(*FString::Printf(TEXT("Could not create typed This property %s, is a variable already using that name?"), *PropertyName.ToString()));
+			continue;
+		}
+		
+		// Read-only for the graph, never saved, and not an input of Run Script nodes
+		Property->SetPropertyFlags(CPF_BlueprintVisible | CPF_BlueprintReadOnly | CPF_Transient | CPF_DuplicateTransient | CPF_DisableEditOnInstance);
+		
+		TypedThisProperties.Add(PropertyName);
+	}
+}
+
+// ----------------------------------------------
+
+void FBangoScriptCompilerContext::CopyTermDefaultsToDefaultObject(UObject* DefaultObject)
+{
+	FKismetCompilerContext::CopyTermDefaultsToDefaultObject(DefaultObject);
+	
+	if (UBangoScript* Script = Cast<UBangoScript>(DefaultObject))
+	{
+		Script->TypedThisProperties = TypedThisProperties;
+	}
+}
+
+// ----------------------------------------------
+
+void FBangoScriptCompilerContext::PostExpansionStep(const UEdGraph* Graph)
+{
+	FKismetCompilerContext::PostExpansionStep(Graph);
+	
+	if (!IsPeepholePassEnabled() || !Graph)
+	{
+		return;
+	}
+	
+	// Only ever called on the intermediate graphs of this compile
+	UEdGraph* MutableGraph = const_cast<UEdGraph*>(Graph);
+	
+	const int32 NumCastsRemoved = RemoveRedundantCasts(MutableGraph);
+	const int32 NumActorRefsRemoved = MergeDuplicateActorRefs(MutableGraph);
+	const int32 NumPollsRemoved = RemoveConstantSleepConditionPolls(MutableGraph);
+	
+	UBangoExpansionStatsSubsystem::RecordPeephole(Blueprint, TEXT("RedundantCasts"), NumCastsRemoved);
+	UBangoExpansionStatsSubsystem::RecordPeephole(Blueprint, TEXT("DuplicateActorRefs"), NumActorRefsRemoved);
+	UBangoExpansionStatsSubsystem::RecordPeephole(Blueprint, TEXT("ConstantSleepConditions"), NumPollsRemoved);
+	
+	UE_LOG(LogBangoEditor, Verbose, TEXT("Peephole pass on %s (%s): %i casts, %i actor lookups, %i sleep condition polls removed"),
+		*Blueprint->GetName(), *Graph->GetName(), NumCastsRemoved, NumActorRefsRemoved, NumPollsRemoved);
+}
+
+// ----------------------------------------------
+
+void FBangoScriptCompilerContext::PostCompile()
+{
+	FKismetCompilerContext::PostCompile();
+	
+	if (!bIsFullCompile || MessageLog.NumErrors > 0)
+	{
+		return;
+	}
+	
+	int32 BytecodeSize = 0;
+	int32 NumStatements = 0;
+	
+	for (const FKismetFunctionContext& FunctionContext : FunctionList)
+	{
+		BytecodeSize += FunctionContext.Function ? FunctionContext.Function->Script.Num() : 0;
+		NumStatements += FunctionContext.AllGeneratedStatements.Num();
+	}
+	
+	UBangoExpansionStatsSubsystem::RecordCompiledCode(Blueprint, IsPeepholePassEnabled(), BytecodeSize, NumStatements);
+}
+
+// ----------------------------------------------
+
+int32 FBangoScriptCompilerContext::RemoveRedundantCasts(UEdGraph* Graph)
+{
+	TMap<TTuple<UEdGraphPin*, UClass*, UEdGraphNode*>, UK2Node_DynamicCast*> CastsBySource;
+	TArray<UEdGraphNode*> NodesToRemove;
+	
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node);
+		
+		if (!CastNode || !CastNode->IsNodePure() || !CastNode->TargetType)
+		{
+			continue;
+		}
+		
+		UEdGraphPin* SourcePin = CastNode->GetCastSourcePin();
+		UEdGraphPin* ResultPin = CastNode->GetCastResultPin();
+		UEdGraphPin* SuccessPin = CastNode->GetBoolSuccessPin();
+		
+		if (!SourcePin || !ResultPin || SourcePin->LinkedTo.Num() != 1)
+		{
+			continue;
+		}
+		
+		UEdGraphPin* ObjectPin = SourcePin->LinkedTo[0];
+		UClass* SourceClass = Cast<UClass>(ObjectPin->PinType.PinSubCategoryObject.Get());
+		
+		// Upcast or same type, the cast can't fail so its result is the source itself
+		const bool bCanBypass = ObjectPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Object && SourceClass && SourceClass->IsChildOf(CastNode->TargetType);
+		
+		if (bCanBypass && (!SuccessPin || SuccessPin->LinkedTo.IsEmpty()))
+		{
+			RelinkConsumers(ResultPin, ObjectPin);
+			NodesToRemove.Add(CastNode);
+			continue;
+		}
+		
+		UEdGraphNode* Consumer = GetSingleImpureConsumer(CastNode);
+		
+		if (!Consumer)
+		{
+			continue;
+		}
+		
+		UK2Node_DynamicCast*& FirstCast = CastsBySource.FindOrAdd( { ObjectPin, CastNode->TargetType.Get(), Consumer } );
+		
+		if (!FirstCast)
+		{
+			FirstCast = CastNode;
+			continue;
+		}
+		
+		UEdGraphPin* FirstSuccessPin = FirstCast->GetBoolSuccessPin();
+		
+		if (SuccessPin && !SuccessPin->LinkedTo.IsEmpty() && !FirstSuccessPin)
+		{
+			continue;
+		}
+		
+		// Same source, same target type, same consumer: the consumer can read everything from the first cast
+		RelinkConsumers(ResultPin, FirstCast->GetCastResultPin());
+		
+		if (SuccessPin && !SuccessPin->LinkedTo.IsEmpty())
+		{
+			RelinkConsumers(SuccessPin, FirstSuccessPin);
+		}
+		
+		NodesToRemove.Add(CastNode);
+	}
+	
+	for (UEdGraphNode* Node : NodesToRemove)
+	{
+		Node->BreakAllNodeLinks();
+		Graph->RemoveNode(Node);
+	}
+	
+	return NodesToRemove.Num();
+}
+
+// ----------------------------------------------
+
+int32 FBangoScriptCompilerContext::MergeDuplicateActorRefs(UEdGraph* Graph)
+{
+	TMap<TPair<FString, UEdGraphNode*>, UK2Node_CallFunction*> LookupsByIndex;
+	TArray<UEdGraphNode*> NodesToRemove;
+	
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
+		
+		if (!CallNode || !IsCallTo(CallNode, GET_FUNCTION_NAME_CHECKED(UBangoScript, GetActorRef)))
+		{
+			continue;
+		}
+		
+		UEdGraphPin* IndexPin = CallNode->FindPin(TEXT("Index"));
+		UEdGraphPin* SelfPin = CallNode->FindPin(UEdGraphSchema_K2::PN_Self);
+		UEdGraphPin* ReturnPin = CallNode->GetReturnValuePin();
+		
+		// FindActor always feeds a literal index into a call on self; anything else is left alone
+		if (!IndexPin || !ReturnPin || !IndexPin->LinkedTo.IsEmpty() || (SelfPin && !SelfPin->LinkedTo.IsEmpty()))
+		{
+			continue;
+		}
+		
+		UEdGraphNode* Consumer = GetSingleImpureConsumer(CallNode);
+		
+		if (!Consumer)
+		{
+			continue;
+		}
+		
+		UK2Node_CallFunction*& FirstLookup = LookupsByIndex.FindOrAdd( { IndexPin->DefaultValue, Consumer } );
+		
+		if (!FirstLookup)
+		{
+			FirstLookup = CallNode;
+			continue;
+		}
+		
+		RelinkConsumers(ReturnPin, FirstLookup->GetReturnValuePin());
+		NodesToRemove.Add(CallNode);
+	}
+	
+	for (UEdGraphNode* Node : NodesToRemove)
+	{
+		Node->BreakAllNodeLinks();
+		Graph->RemoveNode(Node);
+	}
+	
+	return NodesToRemove.Num();
+}
+
+// ----------------------------------------------
+
+int32 FBangoScriptCompilerContext::RemoveConstantSleepConditionPolls(UEdGraph* Graph)
+{
+	static const FName ConditionPinNames[] = { TEXT("bSkip"), TEXT("bCancel"), TEXT("bPaused") };
+	
+	TArray<UEdGraphNode*> NodesToRemove;
+	
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
+		
+		if (!CallNode || !IsCallTo(CallNode, GET_FUNCTION_NAME_CHECKED(UBangoScript, SetSleepConditions_Internal)))
+		{
+			continue;
+		}
+		
+		bool bAllConditionsFalse = true;
+		
+		for (FName ConditionPinName : ConditionPinNames)
+		{
+			UEdGraphPin* ConditionPin = CallNode->FindPin(ConditionPinName);
+			
+			if (!ConditionPin || !ConditionPin->LinkedTo.IsEmpty() || ConditionPin->GetDefaultAsString().ToBool())
+			{
+				bAllConditionsFalse = false;
+				break;
+			}
+		}
+		
+		if (!bAllConditionsFalse)
+		{
+			continue;
+		}
+		
+		// The Sleep expansion makes a tick event that only calls this. Without the event, the sleep action never gets a tick delegate.
+		UEdGraphPin* ExecPin = CallNode->GetExecPin();
+		UEdGraphPin* ThenPin = CallNode->GetThenPin();
+		
+		if (!ExecPin || ExecPin->LinkedTo.Num() != 1 || (ThenPin && !ThenPin->LinkedTo.IsEmpty()))
+		{
+			continue;
+		}
+		
+		UK2Node_CustomEvent* TickEvent = Cast<UK2Node_CustomEvent>(ExecPin->LinkedTo[0]->GetOwningNode());
+		
+		if (!TickEvent || TickEvent->GetThenPin()->LinkedTo.Num() != 1)
+		{
+			continue;
+		}
+		
+		NodesToRemove.Add(TickEvent);
+		NodesToRemove.Add(CallNode);
+	}
+	
+	for (UEdGraphNode* Node : NodesToRemove)
+	{
+		Node->BreakAllNodeLinks();
+		Graph->RemoveNode(Node);
+	}
+	
+	return NodesToRemove.Num();
+}
+
+// ----------------------------------------------
+
+void FBangoScriptCompilerContext::RelinkConsumers(UEdGraphPin* From, UEdGraphPin* To)
+{
+	TArray<UEdGraphPin*> Consumers = From->LinkedTo;
+	From->BreakAllPinLinks();
+	
+	for (UEdGraphPin* Consumer : Consumers)
+	{
+		To->MakeLinkTo(Consumer);
+	}
+}
+
+// ----------------------------------------------
+
+UEdGraphNode* FBangoScriptCompilerContext::GetSingleImpureConsumer(const UEdGraphNode* PureNode)
+{
+	UEdGraphNode* Consumer = nullptr;
+	
+	for (const UEdGraphPin* Pin : PureNode->Pins)
+	{
+		if (Pin->Direction != EGPD_Output)
+		{
+			continue;
+		}
+		
+		for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+		{
+			UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
+			
+			if (Consumer && Consumer != LinkedNode)
+			{
+				return nullptr;
+			}
+			
+			Consumer = LinkedNode;
+		}
+	}
+	
+	const UK2Node* ConsumerK2Node = Cast<UK2Node>(Consumer);
+	
+	return ConsumerK2Node && !ConsumerK2Node->IsNodePure() ? Consumer : nullptr;
+}
+
+// ----------------------------------------------
+
+bool FBangoScriptCompilerContext::IsCallTo(const UK2Node_CallFunction* CallNode, FName FunctionName)
+{
+	const UFunction* Function = CallNode->GetTargetFunction();
+	
+	return Function && Function->GetFName() == FunctionName && Function->GetOwnerClass()->IsChildOf(UBangoScript::StaticClass());
+}
@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include "KismetCompiler.h"
+
+class UK2Node_CallFunction;
+
+/**
+ * Compiler used for UBangoScriptBlueprint. It is the stock Kismet compiler, plus:
+ *  - One typed This property per 'This' class used by the script's This nodes. UBangoScript::SetThis fills them in on launch.
+ *  - An optional peephole pass that runs over each graph after node expansion.
+ *
+ * The peephole pass cleans up patterns that the Bango nodes leave behind and that the backend doesn't optimize:
+ *  - Pure casts that can't fail (the source already has the target type), or that duplicate another cast of the same pin.
+ *  - Duplicate GetActorRef lookups of the same actor, from FindActor nodes.
+ *  - Sleep condition polling where every condition is constant false. It would only write temp bools every tick.
+ *
+ * Pure nodes are evaluated again for every impure node that reads them, so two duplicates that feed different impure nodes cost the same as one shared
+ * node. Duplicates are only merged when they both feed the same single impure node.
+ *
+ * Controlled by Bango.Cook.OptimizeScripts (0 = off, 1 = while cooking, 2 = always). Removed nodes are reported through the Bango.ExpansionStats commands.
+ * Every full compile records its bytecode size and statement count with the pass on or off, Bango.ExpansionStats.Peephole compiles both ways and reports
+ * the difference.
+ */
+class FBangoScriptCompilerContext : public FKismetCompilerContext
+{
+public:
+	FBangoScriptCompilerContext(UBlueprint* InBlueprint, FCompilerResultsLog& InMessageLog, const FKismetCompilerOptions& InCompilerOptions);
+	
+	static TSharedPtr<FKismetCompilerContext> MakeCompiler(UBlueprint* InBlueprint, FCompilerResultsLog& InMessageLog, const FKismetCompilerOptions& InCompilerOptions);
+	
+	static bool IsPeepholePassEnabled();
+	
+	// Forces the peephole pass on or off regardless of Bango.Cook.OptimizeScripts, unset to go back to the cvar
+	static void SetPeepholePassOverride(TOptional<bool> bEnabled);
+	
+protected:
+	void CreateClassVariablesFromBlueprint() override;
+	
+	void CopyTermDefaultsToDefaultObject(UObject* DefaultObject) override;
+	
+	void PostExpansionStep(const UEdGraph* Graph) override;
+	
+	void PostCompile() override;
+	
+	// Each pass returns the number of nodes it removed
+	int32 RemoveRedundantCasts(UEdGraph* Graph);
+	
+	int32 MergeDuplicateActorRefs(UEdGraph* Graph);
+	
+	int32 RemoveConstantSleepConditionPolls(UEdGraph* Graph);
+	
+	// Moves every link of From onto To
+	static void RelinkConsumers(UEdGraphPin* From, UEdGraphPin* To);
+	
+	// The impure node that all outputs of PureNode feed, or null if they feed several nodes or another pure node
+	static UEdGraphNode* GetSingleImpureConsumer(const UEdGraphNode* PureNode);
+	
+	static bool IsCallTo(const UK2Node_CallFunction* CallNode, FName FunctionName);
+	
+protected:
+	TArray<FName> TypedThisProperties;
+};
@@ -147,15 +147,17 @@ void UK2Node_BangoFindActor::DestroyNode()
 	{
 		if (IBangoScriptHolderInterface* ScriptHolder = GetBangoScriptBlueprint()->GetScriptHolderMutable())
 		{
-			TSet<TSoftObjectPtr<AActor>>& SoftRefs = ScriptHolder->GetScriptContainer().SoftActorRefs;
-			TSet<TObjectPtr<AActor>>& HardRefs = ScriptHolder->GetScriptContainer().HardActorRefs;
+			FBangoScriptContainer& ScriptContainer = ScriptHolder->GetScriptContainer();
+			TSet<TSoftObjectPtr<AActor>>& SoftRefs = ScriptContainer.SoftActorRefs;
+			TSet<TObjectPtr<AActor>>& HardRefs = ScriptContainer.HardActorRefs;
 
-			if (SoftRefs.Contains(TargetActor) || (TargetActor.IsValid() && HardRefs.Contains(TargetActor.Get())))
+			if (SoftRefs.Contains(TargetActor) || (TargetActor.IsValid() && HardRefs.Contains(TargetActor.Get())) || ScriptContainer.HasStreamingHint(TargetActor))
 			{
 				ScriptHolder->_getUObject()->Modify();
 				
 				SoftRefs.Remove(TargetActor);
 				HardRefs.Remove(TargetActor.Get());
+				ScriptContainer.RemoveStreamingHint(TargetActor);
 			}
 		}
 	}
@@ -268,6 +270,18 @@ void UK2Node_BangoFindActor::ExpandNode_SoftActor(class FKismetCompilerContext&
 	const UEdGraphSchema_K2* Schema = Compiler.GetSchema();
 	bool bIsErrorFree = true;
 
+	UBangoScriptBlueprint* ScriptBlueprint = Cast<UBangoScriptBlueprint>(Compiler.Blueprint);
+	
+	if (!ScriptBlueprint)
+	{
+		Compiler.MessageLog.Error(*LOCTEXT("FindActor_NotAScript", "FindActor can only be used in Bango scripts. @@").ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+	
+	// The path is folded into the class defaults here; at runtime this is a single table lookup and resolve, no string parsing
+	int32 ActorRefIndex = ScriptBlueprint->AddCompiledActorRef(TargetActor.ToSoftObjectPath());
+	
 	namespace NB = BangoNodeBuilder;
 	NB::Builder Builder(Compiler, SourceGraph, this, Schema, &bIsErrorFree, FVector2f(5, 5));
 	
@@ -275,20 +289,13 @@ void UK2Node_BangoFindActor::ExpandNode_SoftActor(class FKismetCompilerContext&
 	// Make nodes
 	
 	auto Node_This =					Builder.WrapExistingNode<NB::BangoFindActor>(this);
-	auto Node_ResolveSoft =				Builder.MakeNode<NB::ConvertAsset>(1, 1);
+	auto Node_GetActorRef =				Builder.MakeNode<NB::CallFunction>(1, 1);
 	auto Node_CastToType =				Builder.MakeNode<NB::DynamicCast_Pure>(1, 1);
-	auto Node_SoftObjectPath =			Builder.MakeNode<NB::CallFunction>(1, 1);
-	auto Node_SoftObjectRef =			Builder.MakeNode<NB::CallFunction>(1, 1);
-	auto Node_ResolveObject =			Builder.MakeNode<NB::CallFunction>(1, 1);
 	
 	// -----------------
 	// Post-setup
 
-	FString UniqueID = *Compiler.GetGuid(this);
-	
-	Node_SoftObjectPath->SetFromFunction(UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeSoftObjectPath)));
-	Node_SoftObjectRef->SetFromFunction(UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, Conv_SoftObjPathToSoftObjRef)));
-	Node_ResolveObject->SetFromFunction(UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, Conv_SoftObjectReferenceToObject)));
+	Node_GetActorRef->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, GetActorRef)));
 	
 	if (IsValid(CastTo))
 	{
@@ -300,25 +307,17 @@ void UK2Node_BangoFindActor::ExpandNode_SoftActor(class FKismetCompilerContext&
 	// -----------------
 	// Make connections
 	
-	UEdGraphPin* PathInput     = Node_SoftObjectPath->FindPin(FName("PathString"));
-	UEdGraphPin* PathOutput    = Node_SoftObjectPath->GetReturnValuePin();
-	UEdGraphPin* SoftRefInput  = Node_SoftObjectRef->FindPin(FName("SoftObjectPath"));
-	UEdGraphPin* SoftRefOutput = Node_SoftObjectRef->GetReturnValuePin();
-	UEdGraphPin* ConvertInput  = Node_ResolveObject->FindPin(FName("SoftObject"));
-	UEdGraphPin* ConvertOutput = Node_ResolveObject->GetReturnValuePin();
-
-	FString ActorPath = TargetActor.ToSoftObjectPath().ToString();
-	Builder.SetDefaultValue(PathInput, ActorPath);
-	
-	Builder.CreateConnection(PathOutput, SoftRefInput);
-	Builder.CreateConnection(SoftRefOutput, ConvertInput);
-	//Builder.CopyExternalConnection(Node_This.FoundActor, ConvertOutput);
+	Builder.SetDefaultValue(Node_GetActorRef.FindPin("Index"), FString::FromInt(ActorRefIndex));
 	
 	if (IsValid(CastTo))
 	{
-		Builder.CreateConnection(ConvertOutput, Node_CastToType.ObjectToCast);
+		Builder.CreateConnection(Node_GetActorRef->GetReturnValuePin(), Node_CastToType.ObjectToCast);
 		Builder.CopyExternalConnection(Node_This.FoundActor, Node_CastToType.CastedObject);
 	}
+	else
+	{
+		Builder.CopyExternalConnection(Node_This.FoundActor, Node_GetActorRef->GetReturnValuePin());
+	}
 	
 	// Done!
 	if (!bIsErrorFree)
@@ -486,16 +485,22 @@ void UK2Node_BangoFindActor::ToggleHard()
 	
 	if (IBangoScriptHolderInterface* ScriptHolder = GetBangoScriptBlueprint()->GetScriptHolderMutable())
 	{
-		TSet<TSoftObjectPtr<AActor>>& SoftActorRefs = ScriptHolder->GetScriptContainer().SoftActorRefs;
-		TSet<TObjectPtr<AActor>>& HardActorRefs = ScriptHolder->GetScriptContainer().HardActorRefs;
+		FBangoScriptContainer& ScriptContainer = ScriptHolder->GetScriptContainer();
+		TSet<TSoftObjectPtr<AActor>>& SoftActorRefs = ScriptContainer.SoftActorRefs;
+		TSet<TObjectPtr<AActor>>& HardActorRefs = ScriptContainer.HardActorRefs;
 
 		ScriptHolder->_getUObject()->Modify();
 		
+		// Cycles Soft -> Hard -> Streaming Hint -> Soft
 		if (SoftActorRefs.Remove(TargetActor))
 		{
 			HardActorRefs.Add(Actor);
 		}
 		else if (HardActorRefs.Remove(Actor))
+		{
+			ScriptContainer.AddStreamingHint(Actor);
+		}
+		else if (ScriptContainer.RemoveStreamingHint(TargetActor))
 		{
 			SoftActorRefs.Add(TargetActor);
 		}
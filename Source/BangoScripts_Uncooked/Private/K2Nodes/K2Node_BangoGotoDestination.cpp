@@ -3,6 +3,7 @@
 #include "BangoScripts/Uncooked/K2Nodes/K2Node_BangoGotoStart.h"
 #include "BangoScripts/Uncooked/K2Nodes/Base/_BangoMenuSubcategories.h"
 #include "BangoScripts/Uncooked/NodeBuilder/BangoNodeBuilder_Macros.h"
+#include "Subsystems/BangoNamedReroutesHelper.h"
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
@@ -52,28 +53,15 @@ void UK2Node_BangoGotoDestination::ExpandNode(class FKismetCompilerContext& Comp
 	// -----------------
 	// Make connections
 
-	bool bFoundConnection = false;
-	
 	if (!Node_This.Exec->HasAnyConnections())
 	{
 		// We haven't been wired up yet. Let's see if we can do it ourselves?
+		const FBangoGotoIndex::FEntry* GotoEntry = UBangoNamedReroutesHelper::GetGotoIndex(SourceGraph).Find(GetRerouteName());
 		
-		for (TObjectPtr<class UEdGraphNode> Node : SourceGraph->Nodes)
+		if (GotoEntry && GotoEntry->Starts.Num() > 1)
 		{
-			if (UK2Node_BangoGotoStart* SourceNode = Cast<UK2Node_BangoGotoStart>(Node))
-			{
-				if (SourceNode->GetRerouteName() == this->GetRerouteName())
-				{
-					if (bFoundConnection)
-					{
-						bIsErrorFree = false;
-						Compiler.MessageLog.Error(TEXT("Check your GOTO nodes; there is more than one source node sharing the same name."));
-						break;
-					}
-					
-					bFoundConnection = true;
-				}
-			} 
+			bIsErrorFree = false;
+			Compiler.MessageLog.Error(TEXT("Check your GOTO nodes; there is more than one source node sharing the same name."));
 		}
 	}
 	
@@ -3,6 +3,7 @@
 #include "BangoScripts/Uncooked/K2Nodes/K2Node_BangoGotoDestination.h"
 #include "BangoScripts/Uncooked/K2Nodes/Base/_BangoMenuSubcategories.h"
 #include "BangoScripts/Uncooked/NodeBuilder/BangoNodeBuilder.h"
+#include "Subsystems/BangoNamedReroutesHelper.h"
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
@@ -73,20 +74,17 @@ void UK2Node_BangoGotoStart::ExpandNode(class FKismetCompilerContext& Compiler,
 		}	
 	}
 	
-	for (TObjectPtr<class UEdGraphNode> Node : SourceGraph->Nodes)
+	if (const FBangoGotoIndex::FEntry* GotoEntry = UBangoNamedReroutesHelper::GetGotoIndex(SourceGraph).Find(GetRerouteName()))
 	{
-		if (UK2Node_BangoGotoDestination* DestinationNode = Cast<UK2Node_BangoGotoDestination>(Node))
+		for (UK2Node_BangoGotoDestination* DestinationNode : GotoEntry->Destinations)
 		{
-			if (DestinationNode->GetRerouteName() == this->GetRerouteName())
+			while (!Node_Sequence->GetThenPinGivenIndex(ConnectionsMade))
 			{
-				while (!Node_Sequence->GetThenPinGivenIndex(ConnectionsMade))
-				{
-					Node_Sequence->AddInputPin();
-				}
-				
-				Builder.CreateConnection(Node_Sequence->GetThenPinGivenIndex(ConnectionsMade++), DestinationNode->GetExpandedExecPin());
+				Node_Sequence->AddInputPin();
 			}
-		} 
+			
+			Builder.CreateConnection(Node_Sequence->GetThenPinGivenIndex(ConnectionsMade++), DestinationNode->GetExpandedExecPin());
+		}
 	}
 	
 	// Done!
@@ -2,39 +2,124 @@
 
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BlueprintNodeSpawner.h"
-#include "K2Node_AddDelegate.h"
 #include "K2Node_CallFunction.h"
-#include "K2Node_ConstructObjectFromClass.h"
-#include "K2Node_CreateDelegate.h"
 #include "K2Node_CustomEvent.h"
-#include "K2Node_GenericCreateObject.h"
-#include "K2Node_TemporaryVariable.h"
 #include "KismetCompiler.h"
 #include "BangoScripts/Core/BangoScript.h"
-#include "BangoScripts/Subsystem/BangoScriptSubsystem.h"
 #include "BangoScripts/Uncooked/K2Nodes/Base/_BangoMenuSubcategories.h"
 #include "BangoScripts/Uncooked/NodeBuilder/BangoNodeBuilder.h"
 #include "BangoScripts/Uncooked/NodeBuilder/BangoNodeBuilder_Macros.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "Editor.h"
+#include "UObject/ObjectKey.h"
 #include "UObject/PropertyIterator.h"
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
-#define TRY_PARSE_PIN_TYPE(TYPE)\
-	if (!bAddPin && PropertyClass == F##TYPE##Property::StaticClass())\
-	{\
-		bAddPin = true;\
-		PinTypeName = UEdGraphSchema_K2::PC_##TYPE;\
+namespace Bango::RunScriptPins
+{
+	struct FScriptInputPin
+	{
+		FName Name;
+		FEdGraphPinType PinType;
+	};
+	
+	// Input pins a script class exposes on Run Script nodes, in property order
+	struct FScriptPinSignature
+	{
+		TArray<FScriptInputPin> Inputs;
+		TMap<FName, FEdGraphPinType> PinTypesByName;
+	};
+	
+	// Signatures are cached per class and dropped whenever any blueprint compiles, since a recompile changes the class's properties in place
+	static TMap<TObjectKey<UClass>, FScriptPinSignature> SignatureCache;
+	
+	static void FlushSignatureCache()
+	{
+		SignatureCache.Reset();
 	}
-            
-#define TRY_PARSE_PIN_TYPE2(TYPE, TYPE2)\
-	if (!bAddPin && PropertyClass == F##TYPE##Property::StaticClass())\
-	{\
-		bAddPin = true;\
-		PinTypeName = UEdGraphSchema_K2::PC_##TYPE2;\
+	
+	static const FScriptPinSignature& GetSignature(UClass* ScriptClass)
+	{
+		static bool bBoundToCompiles = false;
+		
+		if (!bBoundToCompiles && GEditor)
+		{
+			GEditor->OnBlueprintPreCompile().AddLambda( [] (UBlueprint*) { FlushSignatureCache(); } );
+			GEditor->OnBlueprintCompiled().AddStatic(&FlushSignatureCache);
+			bBoundToCompiles = true;
+		}
+		
+		if (const FScriptPinSignature* Cached = SignatureCache.Find(ScriptClass))
+		{
+			return *Cached;
+		}
+		
+		FScriptPinSignature& Signature = SignatureCache.Add(ScriptClass);
+		
+		for (TFieldIterator<FProperty> PropIt(ScriptClass); PropIt; ++PropIt)
+		{
+			const FProperty* Property = *PropIt;
+			
+			if (Property->HasAnyPropertyFlags(CPF_DisableEditOnInstance | CPF_Transient) || Property->IsNative())
+			{
+				continue;
+			}
+			
+			// The full type, so that a changed struct, class, enum or container is caught and not just a changed category.
+			// Maps can't be carried in the property bag the inputs travel in.
+			FEdGraphPinType PinType;
+			
+			if (!GetDefault<UEdGraphSchema_K2>()->ConvertPropertyToPinType(Property, PinType) || PinType.IsMap())
+			{
+				continue;
+			}
+			
+			Signature.Inputs.Add( { Property->GetFName(), PinType } );
+			Signature.PinTypesByName.Add(Property->GetFName(), PinType);
+		}
+		
+		return Signature;
 	}
-
-class UK2Node_IfThenElse;
+	
+	// Compares against the pins themselves rather than remembering what was applied last, so that undo/redo can't leave the two out of sync
+	static bool DoArgumentPinsMatch(const TArray<UEdGraphPin*>& Pins, const UEdGraphPin* ScriptPin, const TArray<FName>& PinNames, const FScriptPinSignature& Signature)
+	{
+		if (PinNames.Num() != Signature.Inputs.Num())
+		{
+			return false;
+		}
+		
+		for (int32 i = 0; i < PinNames.Num(); ++i)
+		{
+			if (PinNames[i] != Signature.Inputs[i].Name)
+			{
+				return false;
+			}
+		}
+		
+		// Pins kept from a previous script can sit in a different order than the inputs, only names and types have to line up
+		int32 NumArgumentPins = 0;
+		
+		for (const UEdGraphPin* Pin : Pins)
+		{
+			if (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec || Pin == ScriptPin || Pin->Direction != EGPD_Input)
+			{
+				continue;
+			}
+			
+			const FEdGraphPinType* PinType = Signature.PinTypesByName.Find(Pin->PinName);
+			
+			if (!PinType || *PinType != Pin->PinType)
+			{
+				return false;
+			}
+			
+			++NumArgumentPins;
+		}
+		
+		return NumArgumentPins == Signature.Inputs.Num();
+	}
+}
 
 UK2Node_BangoRunScript::UK2Node_BangoRunScript()
 {
@@ -108,112 +193,86 @@ void UK2Node_BangoRunScript::ExpandNode(class FKismetCompilerContext& Compiler,
 	// Make nodes
 	
 	auto Node_This =					Builder.WrapExistingNode<NB::BangoRunScript>(this);
-	auto Node_Self =					Builder.MakeNode<NB::SelfReference>(0, 2);
-	auto Node_CreateScriptObject =		Builder.MakeNode<NB::CreateObject>(1, 1);
-	auto Node_CastToBangoScript =		Builder.MakeNode<NB::DynamicCast_Pure>(5, 5);
-	auto Node_Branch =					Builder.MakeNode<NB::Branch>(3, 2);
-	auto Node_CreateDelegate =			Builder.MakeNode<NB::CreateDelegate>(4, 1);
-	auto Node_AddDelegate =				Builder.MakeNode<NB::AddDelegate>(4, 0);
-	auto Node_ExecuteScript =			Builder.MakeNode<NB::CallFunction>(5, 1);
-	auto Node_ScriptCompletedEvent =	Builder.MakeNode<NB::CustomEvent>(6, 1);
+	auto Node_RunScript =				Builder.MakeNode<NB::BangoRunScript_Internal>(1, 1);
 
 	// -----------------
-	// Post-setup
-
-	// Update the ConstructObject class pin; we need to generate pin collections before and after assigning the class so we can get the extra pins
-	if (UClass* ScriptClass = Cast<UClass>(Node_This.Script->DefaultObject))
+	// Script class and inputs
+	
+	if (Node_This.Script->HasAnyConnections())
 	{
-		// There is a script set, we need to generate dynamic pins. Set the script, this will cause the intermediate script object creator to generate pins.
-		Builder.SetDefaultObject(Node_CreateScriptObject.ObjectClass, Node_This.Script->DefaultObject);
-
-		// We'll try to guess what pins we have by finding ExposeOnSpawn properties. This should be accurate? TODO investigate this more?
-		TArray<FName> ExposeOnSpawnProperties;
+		Builder.MoveExternalConnection(Node_This.Script, Node_RunScript.ScriptClass);
+	}
+	else
+	{
+		Builder.SetDefaultObject(Node_RunScript.ScriptClass, Node_This.Script->DefaultObject);
+	}
+	
+	// Only inputs that were actually set on this node are passed along, the rest keep the script's defaults. Each one becomes a variadic argument
+	// of RunScript_Internal, in the same order as the names list. The argument pins are typed from the script's properties rather than from this
+	// node's pins, which may be stale; the subsystem copies the values straight into those properties.
+	UClass* ScriptClass = Cast<UClass>(Node_This.Script->DefaultObject);
+	
+	static const Bango::RunScriptPins::FScriptPinSignature EmptySignature;
+	const Bango::RunScriptPins::FScriptPinSignature& Signature = ScriptClass ? Bango::RunScriptPins::GetSignature(ScriptClass) : EmptySignature;
+	
+	FString InputNamesValue;
+	
+	for (const FName& PinName : PinNames)
+	{
+		UEdGraphPin* InputPin = FindPropertyPin(PinName);
 		
-		for (TFieldIterator<FProperty> It(ScriptClass); It; ++It)
+		if (!InputPin || (InputPin->DoesDefaultValueMatchAutogenerated() && !InputPin->HasAnyConnections()))
 		{
-			FProperty* Property = *It;
-
-			if (Property->HasAllPropertyFlags(CPF_ExposeOnSpawn))
-			{
-				ExposeOnSpawnProperties.Add(Property->GetFName());
-			}
+			continue;
 		}
 		
-		for (FName PropertyName : ExposeOnSpawnProperties)
+		const FEdGraphPinType* ScriptPinType = Signature.PinTypesByName.Find(PinName);
+		
+		if (!ScriptPinType || *ScriptPinType != InputPin->PinType)
 		{
-			UEdGraphPin* ThisExposeOnSpawnPin = FindPin(PropertyName);
-			UEdGraphPin* ConstructScriptExposeOnSpawnPin = Node_CreateScriptObject->FindPin(PropertyName);
-
-			if (ThisExposeOnSpawnPin && ConstructScriptExposeOnSpawnPin)
-			{
-				// If the dynamic pin has a hardcoded value set directly on it...
-				if (!ThisExposeOnSpawnPin->DoesDefaultValueMatchAutogenerated())
-				{
-					Builder.SetDefaultValue(ConstructScriptExposeOnSpawnPin, ThisExposeOnSpawnPin->DefaultValue);
-				}
-				// If the dynamic pin has a connection...
-				else if (ThisExposeOnSpawnPin->HasAnyConnections())
-				{
-					Builder.MoveExternalConnection(ThisExposeOnSpawnPin, ConstructScriptExposeOnSpawnPin);
-				}
-			}
+			Compiler.MessageLog.Error(*FText::Format(LOCTEXT("RunScript_StaleInput", "Input '{0}' on @@ no longer matches the script, refresh the node."), FText::FromName(PinName)).ToString(), this);
+			continue;
 		}
+		
+		UEdGraphPin* ArgumentPin = Node_RunScript->CreatePin(EGPD_Input, *ScriptPinType, *FString::Printf(TEXT("Input_%s"), *PinName.ToString()));
+		
+		// Moves the default value (including object and text defaults) along with any links
+		Builder.MoveExternalConnection(InputPin, ArgumentPin);
+		
+		InputNamesValue += InputNamesValue.IsEmpty() ? TEXT("(") : TEXT(",");
+		InputNamesValue += FString::Printf(TEXT("\"%s\""), *PinName.ToString());
 	}
-
-	UClass* ObjectClass = nullptr;
 	
-	if (!Node_This.Script->HasAnyConnections())
+	if (!InputNamesValue.IsEmpty())
 	{
-		ObjectClass = Cast<UClass>(Node_CreateScriptObject.ObjectClass->DefaultObject);
+		InputNamesValue += TEXT(")");
+		Builder.SetDefaultValue(Node_RunScript.InputNames, InputNamesValue);
 	}
 	
-	FProperty* OnFinishDelegate = UBangoScript::StaticClass()->FindPropertyByName(GET_MEMBER_NAME_CHECKED(UBangoScript, OnFinishDelegate));
-	Node_AddDelegate->SetFromProperty(OnFinishDelegate, false, UBangoScript::StaticClass());
-	
-	Node_ScriptCompletedEvent->CustomFunctionName = *FString::Printf(TEXT("%s_%s"), TEXT("OnFinishedDelegate"), *Compiler.GetGuid(this));
-	
-	Node_CastToBangoScript->TargetType = UBangoScript::StaticClass(); 
-	
-	Node_ExecuteScript->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UBangoScriptSubsystem, K2_EnqueueScript), UBangoScriptSubsystem::StaticClass());
-	
-	Builder.FinishDeferredNodes(true);
-
 	// -----------------
-	// Make connections
-
-	// Exec paths
-	Builder.MoveExternalConnection(Node_This.Exec, Node_CreateScriptObject.Exec);
-	Builder.CreateConnection(Node_CreateScriptObject.Then, Node_Branch.Exec);
-	Builder.CreateConnection(Node_Branch.Then, Node_AddDelegate.Exec);
-	Builder.CreateConnection(Node_AddDelegate.Then, Node_ExecuteScript.Exec);
-	Builder.MoveExternalConnection(Node_This.Then, Node_ExecuteScript.Then);
-	Builder.MoveExternalConnection(Node_This.Completed, Node_ScriptCompletedEvent.Then);
-	
-	// Data paths
+	// Finish event, only needed if something listens to it
 	
-	Node_CreateDelegate->SetFunction(Node_ScriptCompletedEvent->CustomFunctionName);
-	
-	if (Node_This.Script->HasAnyConnections())
+	if (Node_This.Completed->HasAnyConnections())
 	{
-		Builder.MoveExternalConnection(Node_This.Script, Node_CreateScriptObject.ObjectClass);
+		auto Node_ScriptFinishedEvent =	Builder.MakeNode<NB::CustomEvent>(2, 2);
+		Node_ScriptFinishedEvent->CustomFunctionName = *FString::Printf(TEXT("%s_%s"), TEXT("OnFinishedDelegate"), *Compiler.GetGuid(this));
+		
+		Builder.FinishDeferredNodes(true);
+		
+		Builder.CreateConnection(Node_ScriptFinishedEvent.Delegate, Node_RunScript.OnFinished);
+		Builder.MoveExternalConnection(Node_This.Completed, Node_ScriptFinishedEvent.Then);
 	}
-	else if (ObjectClass)
+	else
 	{
-		Builder.CreateConnection(Node_AddDelegate.Delegate, Node_CreateDelegate.DelegateOut);
+		Builder.FinishDeferredNodes(true);
 	}
 	
-	Builder.CreateConnection(Node_CastToBangoScript.CastedObject, Node_AddDelegate.Target);
-	
-
-	Builder.CreateConnection(Node_CreateScriptObject.CreatedObject, Node_CastToBangoScript.ObjectToCast);
-	Builder.CreateConnection(Node_CastToBangoScript.Success, Node_Branch.Condition);
-		
-	Builder.CreateConnection(Node_CastToBangoScript.CastedObject, Node_ExecuteScript.Target);
-	//Builder.CreateConnection(Node_CastToBangoScript.CastedObject, Node_AddDelegate.Target);
-	Builder.CreateConnection(Node_ScriptCompletedEvent.Delegate, Node_AddDelegate.Delegate);
+	// -----------------
+	// Make connections
 	
-	// Final output
-	//Builder.MoveExternalConnection(Node_This.Handle, Node_ExecuteScript.Result);
+	Builder.MoveExternalConnection(Node_This.Exec, Node_RunScript.Exec);
+	Builder.MoveExternalConnection(Node_This.Then, Node_RunScript.Then);
+	Builder.MoveExternalConnection(Node_This.Handle, Node_RunScript.Handle);
 
 	if (!bIsErrorFree)
 	{
@@ -226,6 +285,21 @@ void UK2Node_BangoRunScript::ExpandNode(class FKismetCompilerContext& Compiler,
 
 #undef MAKE_BASIC_NODE_OLD
 
+bool UK2Node_BangoRunScript::HasExternalDependencies(TArray<class UStruct*>* OptionalOutput) const
+{
+	UClass* ScriptClass = Cast<UClass>(GetScriptPin()->DefaultObject);
+	const bool bResult = ScriptClass && ScriptClass->ClassGeneratedBy != nullptr;
+	
+	if (bResult && OptionalOutput)
+	{
+		OptionalOutput->AddUnique(ScriptClass);
+	}
+	
+	const bool bSuperResult = Super::HasExternalDependencies(OptionalOutput);
+	
+	return bSuperResult || bResult;
+}
+
 UEdGraphPin* UK2Node_BangoRunScript::GetScriptPin(const TArray<UEdGraphPin*>* PinsToSearch) const
 {
 	if (PinsToSearch)
@@ -293,11 +367,9 @@ void UK2Node_BangoRunScript::AllocateDefaultPins()
 
 UEdGraphPin* UK2Node_BangoRunScript::FindPropertyPin(const FName InPinName) const
 {
-    //const UEdGraphPin* ScriptPin = GetScriptPin();
-    
     for (UEdGraphPin* Pin : Pins)
     {
-        if( /*Pin != ScriptPin &&*/ Pin->Direction != EGPD_Output && Pin->PinName.ToString().Equals(InPinName.ToString(), ESearchCase::CaseSensitive) )
+        if (Pin->Direction != EGPD_Output && Pin->PinName.IsEqual(InPinName, ENameCase::CaseSensitive))
         {
             return Pin;
         }
@@ -308,84 +380,66 @@ UEdGraphPin* UK2Node_BangoRunScript::FindPropertyPin(const FName InPinName) cons
 
 void UK2Node_BangoRunScript::UpdateScriptPins(UObject* InClassObject)
 {
+	using namespace Bango::RunScriptPins;
+	
 	UClass* InClass = Cast<UClass>(InClassObject);
-
+	
+	static const FScriptPinSignature EmptySignature;
+	const FScriptPinSignature& Signature = InClass ? GetSignature(InClass) : EmptySignature;
+	
+	const UEdGraphPin* ScriptPin = GetScriptPin();
+	
+	// The pins already are the script's inputs, nothing to reconcile
+	if (DoArgumentPinsMatch(Pins, ScriptPin, PinNames, Signature))
+	{
+		return;
+	}
+	
 	bool bChanged = false;
-
-	PinNames.Reset();
-
-	if (InClass)
+	
+	PinNames.Reset(Signature.Inputs.Num());
+	
+	for (const FScriptInputPin& Input : Signature.Inputs)
 	{
-		for (TFieldIterator<FProperty> PropIt(InClass); PropIt; ++PropIt)
-		{
-			FProperty* Property = *PropIt;
-
-			if (!Property->HasAnyPropertyFlags(CPF_DisableEditOnInstance | CPF_Transient) && !Property->IsNative())
-			{
-				FFieldClass* PropertyClass = Property->GetClass();
-        
-				FName PinTypeName;
-				bool bAddPin = false;
-
-				// See EdGraphSchema_K2.h ~line 400 for all types
-				TRY_PARSE_PIN_TYPE2(Bool, Boolean);
-				TRY_PARSE_PIN_TYPE(Byte);
-				TRY_PARSE_PIN_TYPE(Class)
-				TRY_PARSE_PIN_TYPE(SoftClass)
-				TRY_PARSE_PIN_TYPE(Int)
-				TRY_PARSE_PIN_TYPE(Int64)
-				TRY_PARSE_PIN_TYPE(Float)
-				TRY_PARSE_PIN_TYPE(Double)
-				// TRY_PARSE_PIN_TYPE(Real) // TODO Do I need this?
-				TRY_PARSE_PIN_TYPE(Name)
-				TRY_PARSE_PIN_TYPE(Delegate)
-				TRY_PARSE_PIN_TYPE2(MulticastDelegate, MCDelegate)
-				TRY_PARSE_PIN_TYPE(Object)
-				TRY_PARSE_PIN_TYPE(Interface)
-				TRY_PARSE_PIN_TYPE(SoftObject)
-				TRY_PARSE_PIN_TYPE2(Str, String)
-				TRY_PARSE_PIN_TYPE(Text)
-				TRY_PARSE_PIN_TYPE(Struct)
-				// TRY_PARSE_PIN_TYPE(Wildcard) // I should not need this
-				TRY_PARSE_PIN_TYPE(Enum)
-				TRY_PARSE_PIN_TYPE(FieldPath)
-        
-				if (bAddPin)
-				{
-					PinNames.Add(FName(Property->GetName()));
-
-					bool bPinExists = !!FindPropertyPin(Property->GetFName());
-					if (!bPinExists)
-					{
-						CreatePin(EGPD_Input, PinTypeName, FName(Property->GetName()));
-						bChanged = true;
-					}   
-				}
-			}
-		}
+		PinNames.Add(Input.Name);
 	}
-    
-	const UEdGraphPin* ScriptPin = GetScriptPin();
-    
+	
+	// Drop argument pins the script no longer has (or whose type changed), remember the ones that can stay
+	TSet<FName> ExistingPinNames;
+	ExistingPinNames.Reserve(Signature.Inputs.Num());
+	
     for (auto It = Pins.CreateIterator(); It; ++It)
     {
         UEdGraphPin* CheckPin = *It;
         
-        if (CheckPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec && CheckPin != ScriptPin && CheckPin->Direction == EGPD_Input)
+        if (CheckPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec || CheckPin == ScriptPin || CheckPin->Direction != EGPD_Input)
+        {
+        	continue;
+        }
+        
+        const FEdGraphPinType* PinType = Signature.PinTypesByName.Find(CheckPin->PinName);
+        
+        if (PinType && *PinType == CheckPin->PinType)
         {
-            const bool bIsValidArgPin = PinNames.ContainsByPredicate([&CheckPin](const FName& InPinName)
-            {
-                return InPinName == CheckPin->PinName;
-            });
-
-            if(!bIsValidArgPin)
-            {
-                CheckPin->MarkAsGarbage();
-                It.RemoveCurrent();
-            	bChanged = true;
-            }
+        	ExistingPinNames.Add(CheckPin->PinName);
+        	continue;
         }
+        
+        // Break links first, otherwise the pins on the other end keep pointing at the removed pin
+        CheckPin->BreakAllPinLinks(true);
+        CheckPin->MarkAsGarbage();
+        It.RemoveCurrent();
+        bChanged = true;
     }
+	
+	for (const FScriptInputPin& Input : Signature.Inputs)
+	{
+		if (!ExistingPinNames.Contains(Input.Name))
+		{
+			CreatePin(EGPD_Input, Input.PinType, Input.Name);
+			bChanged = true;
+		}
+	}
 
 	if (bChanged)
 	{
@@ -393,4 +447,4 @@ void UK2Node_BangoRunScript::UpdateScriptPins(UObject* InClassObject)
 	}
 }
 
-#undef LOCTEXT_NAMESPACE
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -2,12 +2,8 @@
 
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BlueprintNodeSpawner.h"
-#include "K2Node_AssignmentStatement.h"
 #include "K2Node_CallFunction.h"
-#include "K2Node_CommutativeAssociativeBinaryOperator.h"
 #include "K2Node_CustomEvent.h"
-#include "K2Node_TemporaryVariable.h"
-#include "K2Node_VariableGet.h"
 #include "KismetCompiler.h"
 #include "BangoScripts/Uncooked/K2Nodes/Base/_BangoMenuSubcategories.h"
 #include "BangoScripts/Uncooked/NodeBuilder/BangoNodeBuilder.h"
@@ -16,8 +12,6 @@
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
-class UK2Node_AssignmentStatement;
-
 // ================================================================================================
 
 namespace K2Node_BangoSleepPins
@@ -128,152 +122,77 @@ void UK2Node_BangoSleep::ExpandNode(class FKismetCompilerContext& Compiler, UEdG
 	
 	using namespace BangoNodeBuilder;
 	auto Node_This =					Builder.WrapExistingNode<BangoSleep>(this);
-	auto Node_LaunchSleep = 			Builder.MakeNode<BangoLaunchSleep_Internal>(0, 1);
-	auto Node_SetLatentUUID =			Builder.MakeNode<AssignmentStatement>(1, 1);
-	auto Node_ActionUUID =				Builder.MakeNode<TemporaryVariable>(0, 4);
-	auto Node_CancelExecTriggered =		Builder.MakeNode<TemporaryVariable>(0, 6);
-	auto Node_SkipExecTriggered =		Builder.MakeNode<TemporaryVariable>(0, 8);
-	auto Node_SetCancelExecTriggered =	Builder.MakeNode<AssignmentStatement>(0, 5);
-	auto Node_SetSkipExecTriggered =	Builder.MakeNode<AssignmentStatement>(0, 7);
-	auto Node_TickEvent = 				Builder.MakeNode<CustomEvent>(2, 4); 
-	auto Node_CompleteEvent = 			Builder.MakeNode<CustomEvent>(8, 0);
-	auto Node_CancelBranch = 			Builder.MakeNode<Branch>(4, 6);
-	auto Node_SkipBranch = 				Builder.MakeNode<Branch>(6, 8);
-	auto Node_CancelConditionsOR = 		Builder.MakeNode<BooleanOR>(4, 8);
-	auto Node_SkipConditionsOR = 		Builder.MakeNode<BooleanOR>(6, 10);
-	auto Node_CancelSleep = 			Builder.MakeNode<BangoCancelSleep_Internal>(8, 6);
-	auto Node_SkipSleep = 				Builder.MakeNode<BangoSkipSleep_Internal>(8, 8);
-	auto Node_PauseSleep = 				Builder.MakeNode<BangoPauseSleep_Internal>(8, 10);
-
-	// -----------------
-	// Post-setup
-	
-	Node_SkipExecTriggered->VariableType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	Node_CancelExecTriggered->VariableType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	Node_ActionUUID->VariableType.PinCategory = UEdGraphSchema_K2::PC_Int;
-
-	Node_SetSkipExecTriggered.Value->DefaultValue = "True";
-	Node_SetCancelExecTriggered.Value->DefaultValue = "True";
-	
-	// FBlueprintEditorUtils::FindUniqueCustomEventName does not work. Generate my own unique ID.
-	FString UniqueID = *Compiler.GetGuid(this);
-	Node_TickEvent->CustomFunctionName = FName("Tick" + UniqueID);
-	Node_CompleteEvent->CustomFunctionName = FName("Complete" + UniqueID); 
-	
-	Builder.FinishDeferredNodes();
-	
-	// -----------------
-	// Make connections
-	
-	// Launch Sleep Latent Action inputs
-	Builder.CopyExternalConnection(Node_This.Exec, Node_LaunchSleep.Exec);
-	Builder.CreateConnection(Node_TickEvent.Delegate, Node_LaunchSleep.TickDelegate);
-	Builder.CreateConnection(Node_CompleteEvent.Delegate, Node_LaunchSleep.CompleteDelegate);
-	
-	if (Node_This.Duration)
-	{
-		if (Node_This.Duration->HasAnyConnections())
-		{
-			Builder.CopyExternalConnection(Node_This.Duration, Node_LaunchSleep.Duration);
-		}
-		else
-		{
-			Builder.SetDefaultValue(Node_LaunchSleep.Duration, Node_This.Duration->DefaultValue);
-		}	
-	}
-	else
-	{
-		FString NullDuration = FString::SanitizeFloat(-1.0f);
-		Builder.SetDefaultValue(Node_LaunchSleep.Duration, NullDuration);
-	}
-	
-	// Set Latent Action UUID inputs
-	Builder.CreateConnection(Node_LaunchSleep.Then, Node_SetLatentUUID.Exec);
-	Builder.CreateConnection(Node_ActionUUID.Variable, Node_SetLatentUUID.Variable);
-	Builder.CreateConnection(Node_LaunchSleep.ReturnValue, Node_SetLatentUUID.Value);
+	auto Node_Sleep = 					Builder.MakeNode<BangoSleep_Internal>(0, 1);
 	
-	bool bUseCancel = Node_This.CancelCondition || Node_This.CancelExec;
-	bool bUseSkip = Node_This.SkipCondition || Node_This.SkipExec;
-	bool bUsePause = !!Node_This.PauseCondition;
+	// Condition pins are the only thing that needs script code on tick; everything else is handled by FBangoSleepAction
+	const bool bPollConditions = Node_This.SkipCondition || Node_This.CancelCondition || Node_This.PauseCondition;
 	
-	// Wire up the bottom primary chain	
-	TArray<UEdGraphPin*> ConditionExecFlow = { Node_TickEvent.Then };
-
-	if (bUseCancel)
+	if (bPollConditions)
 	{
-		ConditionExecFlow.Add(Node_CancelBranch.Exec);
-		ConditionExecFlow.Add(Node_CancelBranch.Else);
-		Builder.CreateConnection(Node_CancelConditionsOR.Result, Node_CancelBranch.Condition);
-		Builder.CreateConnection(Node_CancelBranch.Then, Node_CancelSleep.Exec);
-		Builder.CreateConnection(Node_ActionUUID.Variable, Node_CancelSleep.ActionUUID);
+		auto Node_TickEvent = 			Builder.MakeNode<CustomEvent>(0, 3);
+		auto Node_SetConditions = 		Builder.MakeNode<BangoSetSleepConditions_Internal>(1, 3);
+		
+		// FBlueprintEditorUtils::FindUniqueCustomEventName does not work. Generate my own unique ID.
+		FString UniqueID = *Compiler.GetGuid(this);
+		Node_TickEvent->CustomFunctionName = FName("Tick" + UniqueID);
 		
-		if (Node_This.CancelExec)
+		Builder.FinishDeferredNodes();
+		
+		Builder.CreateConnection(Node_TickEvent.Delegate, Node_Sleep.TickDelegate);
+		Builder.CreateConnection(Node_TickEvent.Then, Node_SetConditions.Exec);
+		
+		if (Node_This.SkipCondition)
 		{
-			Builder.CreateConnection(Node_CancelExecTriggered.Variable, Node_CancelConditionsOR.A);
+			Builder.CopyExternalConnection(Node_This.SkipCondition, Node_SetConditions.Skip);
 		}
 		if (Node_This.CancelCondition)
 		{
-			Builder.CopyExternalConnection(Node_This.CancelCondition, Node_CancelConditionsOR.B);
+			Builder.CopyExternalConnection(Node_This.CancelCondition, Node_SetConditions.Cancel);
 		}
-	}
-	if (bUseSkip)
-	{
-		ConditionExecFlow.Add(Node_SkipBranch.Exec);
-		ConditionExecFlow.Add(Node_SkipBranch.Else);
-		Builder.CreateConnection(Node_SkipConditionsOR.Result, Node_SkipBranch.Condition);
-		Builder.CreateConnection(Node_SkipBranch.Then, Node_SkipSleep.Exec);
-		Builder.CreateConnection(Node_ActionUUID.Variable, Node_SkipSleep.ActionUUID);
-		
-		if (Node_This.SkipExec)
-		{
-			Builder.MoveExternalConnection(Node_SkipExecTriggered.Variable, Node_SkipConditionsOR.A);	
-		}
-		if (Node_This.SkipCondition)
+		if (Node_This.PauseCondition)
 		{
-			Builder.MoveExternalConnection(Node_This.SkipCondition, Node_SkipConditionsOR.B);
+			Builder.CopyExternalConnection(Node_This.PauseCondition, Node_SetConditions.Paused);
 		}
 	}
-	if (bUsePause)
+	else
 	{
-		ConditionExecFlow.Add(Node_PauseSleep.Exec);
-		Builder.CreateConnection(Node_ActionUUID.Variable, Node_PauseSleep.ActionUUID);
-
-		if (Node_This.PauseCondition)
-		{
-			Builder.CopyExternalConnection(Node_This.PauseCondition, Node_PauseSleep.Paused);
-		}
+		Builder.FinishDeferredNodes();
 	}
 	
-	// { Tick.Then, Cancel.Exec, Cancel.Else, Skip.Exec, Skip.Else, Pause.Exec };
-	for (int i = 0; i < ConditionExecFlow.Num(); i = i + 2)
+	// -----------------
+	// Make connections
+	
+	Builder.CopyExternalConnection(Node_This.Exec, Node_Sleep.Start);
+	
+	if (Node_This.SkipExec)
 	{
-		if (ConditionExecFlow.IsValidIndex(i + 1))
-		{
-			Builder.CreateConnection(ConditionExecFlow[i], ConditionExecFlow[i + 1]);
-		}
+		Builder.CopyExternalConnection(Node_This.SkipExec, Node_Sleep.Skip);
 	}
-
-	// Exec Skip/Cancel inputs
+	
 	if (Node_This.CancelExec)
 	{
-		Builder.CopyExternalConnection(Node_This.CancelExec, Node_SetCancelExecTriggered.Exec);
-		Builder.CreateConnection(Node_CancelExecTriggered.Variable, Node_SetCancelExecTriggered.Variable);
+		Builder.CopyExternalConnection(Node_This.CancelExec, Node_Sleep.Cancel);
 	}
 	
-	if (Node_This.SkipExec)
+	if (Node_This.Duration)
 	{
-		Builder.CreateConnection(Node_SkipExecTriggered.Variable, Node_SkipConditionsOR.A);
-		Builder.CopyExternalConnection(Node_This.SkipExec, Node_SetSkipExecTriggered.Exec);
-		Builder.CreateConnection(Node_SkipExecTriggered.Variable, Node_SetSkipExecTriggered.Variable);
+		if (Node_This.Duration->HasAnyConnections())
+		{
+			Builder.CopyExternalConnection(Node_This.Duration, Node_Sleep.Duration);
+		}
+		else
+		{
+			Builder.SetDefaultValue(Node_Sleep.Duration, Node_This.Duration->DefaultValue);
+		}	
 	}
-	
-	if (Node_This.PauseCondition)
+	else
 	{
-		Builder.CopyExternalConnection(Node_This.PauseCondition, Node_PauseSleep.Paused);
+		FString NullDuration = FString::SanitizeFloat(-1.0f);
+		Builder.SetDefaultValue(Node_Sleep.Duration, NullDuration);
 	}
 	
 	// Final output
-	Builder.CopyExternalConnection(Node_This.Completed, Node_CompleteEvent.Then);
+	Builder.CopyExternalConnection(Node_This.Completed, Node_Sleep.Then);
 	
 	// Done!
 	if (!bIsErrorFree)
@@ -53,6 +53,19 @@ void UK2Node_BangoThis::AllocateDefaultPins()
 	}
 }
 
+UClass* UK2Node_BangoThis::GetOutputClass() const
+{
+	const UEdGraphPin* ThisPin = FindPin(FName("This"));
+	UClass* OutputClass = ThisPin ? Cast<UClass>(ThisPin->PinType.PinSubCategoryObject.Get()) : nullptr;
+	
+	return OutputClass ? OutputClass : UObject::StaticClass();
+}
+
+FName UK2Node_BangoThis::GetTypedThisPropertyName(const UClass* OutputClass)
+{
+	return *FString::Printf(TEXT("BangoThis_%s_%08X"), *OutputClass->GetName(), GetTypeHash(OutputClass->GetPathName()));
+}
+
 FText UK2Node_BangoThis::GetNodeTitle(ENodeTitleType::Type TitleType) const
 {
 	return LOCTEXT("ThisNode_Title", "This");
@@ -87,27 +100,20 @@ void UK2Node_BangoThis::ExpandNode(class FKismetCompilerContext& Compiler, UEdGr
 	// Make nodes
 	
 	auto Node_This =					Builder.WrapExistingNode<NB::BangoThis>(this);
-	auto Node_ThisLiteral =				Builder.MakeNode<NB::VariableGet>(1,1);
-	auto Node_CastToType =				Builder.MakeNode<NB::DynamicCast_Pure>(1, 1);
+	auto Node_TypedThis =				Builder.MakeNode<NB::VariableGet>(1, 1);
 	
 	// -----------------
 	// Post-setup
 
-	FString UniqueID = *Compiler.GetGuid(this);
-	
-	Node_ThisLiteral->VariableReference.SetSelfMember("This");
-	Node_CastToType->TargetType = Cast<UClass>(Node_This.This->PinType.PinSubCategoryObject);
+	// Added to the class by FBangoScriptCompilerContext and set once when the script launches, so no cast is needed here
+	Node_TypedThis->VariableReference.SetSelfMember(GetTypedThisPropertyName(GetOutputClass()));
 	
 	Builder.FinishDeferredNodes();
 	
 	// -----------------
 	// Make connections
 
-	// First input
-	Builder.CreateConnection(Node_ThisLiteral.Output, Node_CastToType.ObjectToCast);
-	
-	// Final output
-	Builder.MoveExternalConnection(Node_This.This, Node_CastToType.CastedObject);
+	Builder.MoveExternalConnection(Node_This.This, Node_TypedThis.Output);
 	
 	// Done!
 	if (!bIsErrorFree)
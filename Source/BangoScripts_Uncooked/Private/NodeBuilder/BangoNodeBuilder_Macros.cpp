@@ -1,6 +1,9 @@
 ﻿#include "BangoScripts/Uncooked/NodeBuilder/BangoNodeBuilder_Macros.h"
 
+#include "K2Node.h"
+#include "K2Node_TemporaryVariable.h"
 #include "KismetCompiler.h"
+#include "Subsystems/BangoExpansionStatsSubsystem.h"
 
 BangoNodeBuilder::Builder::Builder(class FKismetCompilerContext& InContext, UEdGraph* InParentGraph, class UK2Node* InSourceNode, const UEdGraphSchema* InSchema, bool* InErrorBool, FVector2f Anchor)
 {
@@ -22,6 +25,29 @@ BangoNodeBuilder::Builder::Builder(class FKismetCompilerContext& InContext, UEdG
 	SpawnedNodes.Empty();
 			
 	bAwaitingSpawnFinish = true;
+	
+	_NumGraphNodesAtStart = _ParentGraph->Nodes.Num();
+	_StartTime = FPlatformTime::Seconds();
+}
+
+BangoNodeBuilder::Builder::~Builder()
+{
+	FBangoNodeExpansionStats Stats;
+	Stats.NumExpansions = 1;
+	Stats.ExpandSeconds = FPlatformTime::Seconds() - _StartTime;
+	
+	// Intermediate nodes are always appended, this also catches conversion nodes made by the schema
+	for (int32 i = _NumGraphNodesAtStart; i < _ParentGraph->Nodes.Num(); ++i)
+	{
+		++Stats.NumIntermediateNodes;
+		
+		if (_ParentGraph->Nodes[i] && _ParentGraph->Nodes[i]->IsA<UK2Node_TemporaryVariable>())
+		{
+			++Stats.NumTemporaries;
+		}
+	}
+	
+	UBangoExpansionStatsSubsystem::RecordExpansion(_Compiler->Blueprint, _SourceNode->GetClass(), Stats);
 }
 
 void BangoNodeBuilder::Builder::FinishDeferredNodes(bool bLogUnconnectedPins)
@@ -37,6 +63,14 @@ void BangoNodeBuilder::Builder::FinishDeferredNodes(bool bLogUnconnectedPins)
 	for (NodeWrapper_Base* Node : SpawnedNodes)
 	{
 		Node->DeferredConstruction();
+		
+		for (FName MissingPin : Node->MissingPins)
+		{
+			*_bErrorBool = false;
+			_Compiler->MessageLog.Error(*FString::Printf(TEXT("Bango node builder could not find required pin %s on @@"), *MissingPin.ToString()), Node->BaseNode());
+		}
+
+		Node->MissingPins.Reset();
 
 		if (bLogUnconnectedPins)
 		{
@@ -53,27 +87,59 @@ void BangoNodeBuilder::Builder::FinishDeferredNodes(bool bLogUnconnectedPins)
 	bAwaitingSpawnFinish = false;
 }
 
+// Missing pins were already reported by FinishDeferredNodes, the functions below only need to avoid touching them
+
 void BangoNodeBuilder::Builder::MoveExternalConnection(UEdGraphPin* From, UEdGraphPin* To)
 {
+	if (!From || !To)
+	{
+		*_bErrorBool = false;
+		return;
+	}
+	
 	*_bErrorBool &= _Compiler->MovePinLinksToIntermediate(*From, *To).CanSafeConnect();
 }
 
 void BangoNodeBuilder::Builder::CopyExternalConnection(UEdGraphPin* From, UEdGraphPin* To)
 {
+	if (!From || !To)
+	{
+		*_bErrorBool = false;
+		return;
+	}
+	
 	*_bErrorBool &= _Compiler->MovePinLinksToIntermediate(*From, *To).CanSafeConnect();
 }
 
 void BangoNodeBuilder::Builder::CreateConnection(UEdGraphPin* From, UEdGraphPin* To)
 {
+	if (!From || !To)
+	{
+		*_bErrorBool = false;
+		return;
+	}
+	
 	*_bErrorBool &= _Schema->TryCreateConnection(From, To);
 }
 
-void BangoNodeBuilder::Builder::SetDefaultValue(UEdGraphPin* Pin, FString& Value)
+void BangoNodeBuilder::Builder::SetDefaultValue(UEdGraphPin* Pin, const FString& Value)
 {
+	if (!Pin)
+	{
+		*_bErrorBool = false;
+		return;
+	}
+	
 	_Schema->TrySetDefaultValue(*Pin, Value);
 }
 
 void BangoNodeBuilder::Builder::SetDefaultObject(UEdGraphPin* Pin, UObject* Value)
 {
+	if (!Pin)
+	{
+		*_bErrorBool = false;
+		return;
+	}
+	
 	_Schema->TrySetDefaultObject(*Pin, Value);
 }
@@ -0,0 +1,390 @@
+﻿#include "BangoExpansionStatsSubsystem.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BangoScripts/Core/BangoScriptBlueprint.h"
+#include "Compiler/BangoScriptCompilerContext.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "BangoScripts/EditorTooling/BangoScriptsEditorLog.h"
+
+namespace Bango::ExpansionStats
+{
+	UBangoExpansionStatsSubsystem* Get()
+	{
+		return GEditor ? GEditor->GetEditorSubsystem<UBangoExpansionStatsSubsystem>() : nullptr;
+	}
+	
+	FAutoConsoleCommand LogCommand(
+		TEXT("Bango.ExpansionStats"),
+		TEXT("Logs Bango node expansion statistics gathered from blueprint compiles. Optional argument: number of blueprints to list (default 20)."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([] (const TArray<FString>& Args)
+		{
+			if (UBangoExpansionStatsSubsystem* Subsystem = Get())
+			{
+				Subsystem->LogStats(Args.IsEmpty() ? 20 : FCString::Atoi(*Args[0]));
+			}
+		}));
+	
+	FAutoConsoleCommand CsvCommand(
+		TEXT("Bango.ExpansionStats.Csv"),
+		TEXT("Writes Bango node expansion statistics to a CSV file. Optional argument: file path (default Saved/Profiling/BangoExpansionStats.csv)."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([] (const TArray<FString>& Args)
+		{
+			if (UBangoExpansionStatsSubsystem* Subsystem = Get())
+			{
+				Subsystem->WriteCsv(Args.IsEmpty() ? FPaths::ProfilingDir() / TEXT("BangoExpansionStats.csv") : Args[0]);
+			}
+		}));
+	
+	FAutoConsoleCommand PeepholeCommand(
+		TEXT("Bango.ExpansionStats.Peephole"),
+		TEXT("Compiles every Bango script with the peephole pass off and on, and logs the bytecode size and statement count of both. Optional argument: content path to limit it to."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([] (const TArray<FString>& Args)
+		{
+			if (UBangoExpansionStatsSubsystem* Subsystem = Get())
+			{
+				Subsystem->ComparePeephole(Args.IsEmpty() ? FString() : Args[0]);
+			}
+		}));
+	
+	FAutoConsoleCommand ResetCommand(
+		TEXT("Bango.ExpansionStats.Reset"),
+		TEXT("Clears all gathered Bango node expansion statistics."),
+		FConsoleCommandDelegate::CreateLambda([] ()
+		{
+			if (UBangoExpansionStatsSubsystem* Subsystem = Get())
+			{
+				Subsystem->Reset();
+			}
+		}));
+}
+
+// ----------------------------------------------
+
+int32 FBangoBlueprintExpansionStats::GetNumPeepholeRemovals() const
+{
+	int32 NumRemovals = 0;
+	
+	for (const TPair<FName, int32>& Pass : PeepholeRemovals)
+	{
+		NumRemovals += Pass.Value;
+	}
+	
+	return NumRemovals;
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	
+	PreCompileHandle = GEditor->OnBlueprintPreCompile().AddUObject(this, &ThisClass::OnBlueprintPreCompile);
+	CompiledHandle = GEditor->OnBlueprintCompiled().AddUObject(this, &ThisClass::OnBlueprintCompiled);
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::Deinitialize()
+{
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(PreCompileHandle);
+		GEditor->OnBlueprintCompiled().Remove(CompiledHandle);
+	}
+	
+	Super::Deinitialize();
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::RecordExpansion(UBlueprint* Blueprint, UClass* NodeClass, const FBangoNodeExpansionStats& Stats)
+{
+	UBangoExpansionStatsSubsystem* Subsystem = Bango::ExpansionStats::Get();
+	
+	if (!Subsystem || !Blueprint || !NodeClass)
+	{
+		return;
+	}
+	
+	FBangoBlueprintExpansionStats& BlueprintStats = Subsystem->StatsByBlueprint.FindOrAdd(FSoftObjectPath(Blueprint));
+	BlueprintStats.NodeTypes.FindOrAdd(NodeClass->GetFName()).Accumulate(Stats);
+	
+	Subsystem->PendingBlueprints.AddUnique(Blueprint);
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::RecordPeephole(UBlueprint* Blueprint, FName PassName, int32 NumRemovedNodes)
+{
+	UBangoExpansionStatsSubsystem* Subsystem = Bango::ExpansionStats::Get();
+	
+	if (!Subsystem || !Blueprint || NumRemovedNodes == 0)
+	{
+		return;
+	}
+	
+	Subsystem->StatsByBlueprint.FindOrAdd(FSoftObjectPath(Blueprint)).PeepholeRemovals.FindOrAdd(PassName) += NumRemovedNodes;
+	
+	Subsystem->PendingBlueprints.AddUnique(Blueprint);
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::RecordCompiledCode(UBlueprint* Blueprint, bool bPeepholePass, int32 BytecodeSize, int32 NumStatements)
+{
+	UBangoExpansionStatsSubsystem* Subsystem = Bango::ExpansionStats::Get();
+	
+	if (!Subsystem || !Blueprint)
+	{
+		return;
+	}
+	
+	FBangoPeepholeComparison& Comparison = Subsystem->PeepholeComparisons.FindOrAdd(FSoftObjectPath(Blueprint));
+	FBangoCompiledCodeSize& CodeSize = bPeepholePass ? Comparison.WithPass : Comparison.WithoutPass;
+	
+	CodeSize.BytecodeSize = BytecodeSize;
+	CodeSize.NumStatements = NumStatements;
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	// Only keep the numbers of the latest compile
+	StatsByBlueprint.Remove(FSoftObjectPath(Blueprint));
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::OnBlueprintCompiled()
+{
+	for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : PendingBlueprints)
+	{
+		UBlueprint* Blueprint = WeakBlueprint.Get();
+		
+		if (!Blueprint)
+		{
+			continue;
+		}
+		
+		FBangoBlueprintExpansionStats* BlueprintStats = StatsByBlueprint.Find(FSoftObjectPath(Blueprint));
+		UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(Blueprint->GeneratedClass);
+		
+		if (!BlueprintStats || !GeneratedClass)
+		{
+			continue;
+		}
+		
+		BlueprintStats->BytecodeSize = 0;
+		
+		for (TFieldIterator<UFunction> It(GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+		{
+			BlueprintStats->BytecodeSize += It->Script.Num();
+		}
+		
+		BlueprintStats->PersistentFrameSize = GeneratedClass->UberGraphFunction ? GeneratedClass->UberGraphFunction->GetStructureSize() : 0;
+		
+		if (const int32 NumPeepholeRemovals = BlueprintStats->GetNumPeepholeRemovals())
+		{
+			const FBangoPeepholeComparison* Comparison = PeepholeComparisons.Find(FSoftObjectPath(Blueprint));
+			
+			if (Comparison && Comparison->IsComplete())
+			{
+				UE_LOG(LogBangoEditor, Display, TEXT("%s: peephole pass removed %i nodes, bytecode %i -> %i bytes, statements %i -> %i"),
+					*Blueprint->GetName(), NumPeepholeRemovals, Comparison->WithoutPass.BytecodeSize, Comparison->WithPass.BytecodeSize,
+					Comparison->WithoutPass.NumStatements, Comparison->WithPass.NumStatements);
+			}
+			else
+			{
+				UE_LOG(LogBangoEditor, Display, TEXT("%s: peephole pass removed %i nodes, %i bytes of bytecode and %i bytes of persistent frame left (no baseline, see Bango.ExpansionStats.Peephole)"),
+					*Blueprint->GetName(), NumPeepholeRemovals, BlueprintStats->BytecodeSize, BlueprintStats->PersistentFrameSize);
+			}
+		}
+	}
+	
+	PendingBlueprints.Reset();
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::LogStats(int32 NumBlueprintsToLog) const
+{
+	TMap<FName, FBangoNodeExpansionStats> Totals;
+	int64 TotalBytecodeSize = 0;
+	
+	for (const TPair<FSoftObjectPath, FBangoBlueprintExpansionStats>& BlueprintStats : StatsByBlueprint)
+	{
+		for (const TPair<FName, FBangoNodeExpansionStats>& NodeStats : BlueprintStats.Value.NodeTypes)
+		{
+			Totals.FindOrAdd(NodeStats.Key).Accumulate(NodeStats.Value);
+		}
+		
+		TotalBytecodeSize += BlueprintStats.Value.BytecodeSize;
+	}
+	
+	UE_LOG(LogBangoEditor, Display, TEXT("Bango expansion stats for %i blueprints (%lld bytes of bytecode):"), StatsByBlueprint.Num(), TotalBytecodeSize);
+	UE_LOG(LogBangoEditor, Display, TEXT("    %-40s %10s %10s %10s %10s"), TEXT("Node type"), TEXT("Expanded"), TEXT("Nodes"), TEXT("Temps"), TEXT("ms"));
+	
+	Totals.ValueSort([] (const FBangoNodeExpansionStats& A, const FBangoNodeExpansionStats& B) { return A.NumIntermediateNodes > B.NumIntermediateNodes; });
+	
+	for (const TPair<FName, FBangoNodeExpansionStats>& NodeStats : Totals)
+	{
+		const FBangoNodeExpansionStats& Stats = NodeStats.Value;
+		UE_LOG(LogBangoEditor, Display, TEXT("    %-40s %10i %10i %10i %10.2f"), *NodeStats.Key.ToString(), Stats.NumExpansions, Stats.NumIntermediateNodes, Stats.NumTemporaries, Stats.ExpandSeconds * 1000.0);
+	}
+	
+	TArray<const TPair<FSoftObjectPath, FBangoBlueprintExpansionStats>*> SortedBlueprints;
+	SortedBlueprints.Reserve(StatsByBlueprint.Num());
+	
+	for (const TPair<FSoftObjectPath, FBangoBlueprintExpansionStats>& BlueprintStats : StatsByBlueprint)
+	{
+		SortedBlueprints.Add(&BlueprintStats);
+	}
+	
+	SortedBlueprints.Sort([] (const auto& A, const auto& B) { return A.Value.BytecodeSize > B.Value.BytecodeSize; });
+	
+	UE_LOG(LogBangoEditor, Display, TEXT("    %10s %10s  %s"), TEXT("Bytecode"), TEXT("Frame"), TEXT("Blueprint"));
+	
+	for (int32 i = 0; i < FMath::Min(NumBlueprintsToLog, SortedBlueprints.Num()); ++i)
+	{
+		const FBangoBlueprintExpansionStats& Stats = SortedBlueprints[i]->Value;
+		UE_LOG(LogBangoEditor, Display, TEXT("    %10i %10i  %s"), Stats.BytecodeSize, Stats.PersistentFrameSize, *SortedBlueprints[i]->Key.ToString());
+	}
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::ComparePeephole(const FString& Path)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBangoScriptBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	
+	if (!Path.IsEmpty())
+	{
+		Filter.PackagePaths.Add(FName(Path));
+	}
+	
+	TArray<FAssetData> ScriptAssets;
+	AssetRegistry.GetAssets(Filter, ScriptAssets);
+	
+	// Compile the current setting last, so that the scripts end up the way they would have been compiled anyway
+	const bool bPassEnabled = FBangoScriptCompilerContext::IsPeepholePassEnabled();
+	
+	for (const FAssetData& Asset : ScriptAssets)
+	{
+		UBlueprint* Blueprint = Cast<UBlueprint>(Asset.GetAsset());
+		
+		if (!Blueprint)
+		{
+			continue;
+		}
+		
+		FBangoScriptCompilerContext::SetPeepholePassOverride(!bPassEnabled);
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SkipSave);
+		
+		FBangoScriptCompilerContext::SetPeepholePassOverride(bPassEnabled);
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SkipSave);
+	}
+	
+	FBangoScriptCompilerContext::SetPeepholePassOverride(NullOpt);
+	
+	LogPeepholeComparison();
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::LogPeepholeComparison() const
+{
+	TArray<const TPair<FSoftObjectPath, FBangoPeepholeComparison>*> Comparisons;
+	
+	int64 TotalBytecodeWithout = 0;
+	int64 TotalBytecodeWith = 0;
+	int64 TotalStatementsWithout = 0;
+	int64 TotalStatementsWith = 0;
+	
+	for (const TPair<FSoftObjectPath, FBangoPeepholeComparison>& Comparison : PeepholeComparisons)
+	{
+		if (!Comparison.Value.IsComplete())
+		{
+			continue;
+		}
+		
+		Comparisons.Add(&Comparison);
+		
+		TotalBytecodeWithout += Comparison.Value.WithoutPass.BytecodeSize;
+		TotalBytecodeWith += Comparison.Value.WithPass.BytecodeSize;
+		TotalStatementsWithout += Comparison.Value.WithoutPass.NumStatements;
+		TotalStatementsWith += Comparison.Value.WithPass.NumStatements;
+	}
+	
+	// Biggest savings first
+	Comparisons.Sort([] (const auto& A, const auto& B)
+	{
+		return A.Value.WithoutPass.BytecodeSize - A.Value.WithPass.BytecodeSize > B.Value.WithoutPass.BytecodeSize - B.Value.WithPass.BytecodeSize;
+	});
+	
+	UE_LOG(LogBangoEditor, Display, TEXT("Bango peephole pass on %i blueprints: bytecode %lld -> %lld bytes (%+lld), statements %lld -> %lld (%+lld)"), Comparisons.Num(),
+		TotalBytecodeWithout, TotalBytecodeWith, TotalBytecodeWith - TotalBytecodeWithout, TotalStatementsWithout, TotalStatementsWith, TotalStatementsWith - TotalStatementsWithout);
+	
+	UE_LOG(LogBangoEditor, Display, TEXT("    %10s %10s %8s %10s %10s %8s  %s"), TEXT("Bytes off"), TEXT("Bytes on"), TEXT("Delta"), TEXT("Stmts off"), TEXT("Stmts on"), TEXT("Delta"), TEXT("Blueprint"));
+	
+	for (const TPair<FSoftObjectPath, FBangoPeepholeComparison>* Comparison : Comparisons)
+	{
+		const FBangoCompiledCodeSize& Without = Comparison->Value.WithoutPass;
+		const FBangoCompiledCodeSize& With = Comparison->Value.WithPass;
+		
+		UE_LOG(LogBangoEditor, Display, TEXT("    %10i %10i %+8i %10i %10i %+8i  %s"), Without.BytecodeSize, With.BytecodeSize, With.BytecodeSize - Without.BytecodeSize,
+			Without.NumStatements, With.NumStatements, With.NumStatements - Without.NumStatements, *Comparison->Key.ToString());
+	}
+}
+
+// ----------------------------------------------
+
+bool UBangoExpansionStatsSubsystem::WriteCsv(const FString& FilePath) const
+{
+	TStringBuilder<4096> Csv;
+	Csv << TEXT("Blueprint,NodeType,Expansions,IntermediateNodes,Temporaries,ExpandMs,BlueprintBytecodeBytes,BlueprintPersistentFrameBytes,BlueprintPeepholeRemovedNodes\n");
+	
+	for (const TPair<FSoftObjectPath, FBangoBlueprintExpansionStats>& BlueprintStats : StatsByBlueprint)
+	{
+		const FString BlueprintPath = BlueprintStats.Key.ToString();
+		const int32 NumPeepholeRemovals = BlueprintStats.Value.GetNumPeepholeRemovals();
+		
+		for (const TPair<FName, FBangoNodeExpansionStats>& NodeStats : BlueprintStats.Value.NodeTypes)
+		{
+			const FBangoNodeExpansionStats& Stats = NodeStats.Value;
+			
+			Csv.Appendf(TEXT("%s,%s,%i,%i,%i,%.3f,%i,%i,%i\n"), *BlueprintPath, *NodeStats.Key.ToString(), Stats.NumExpansions, Stats.NumIntermediateNodes, Stats.NumTemporaries,
+				Stats.ExpandSeconds * 1000.0, BlueprintStats.Value.BytecodeSize, BlueprintStats.Value.PersistentFrameSize, NumPeepholeRemovals);
+		}
+	}
+	
+	if (!FFileHelper::SaveStringToFile(Csv.ToView(), *FilePath))
+	{
+		UE_LOG(LogBangoEditor, Error, TEXT("Failed to write Bango expansion stats to %s"), *FilePath);
+		return false;
+	}
+	
+	UE_LOG(LogBangoEditor, Display, TEXT("Wrote Bango expansion stats for %i blueprints to %s"), StatsByBlueprint.Num(), *FilePath);
+	return true;
+}
+
+// ----------------------------------------------
+
+void UBangoExpansionStatsSubsystem::Reset()
+{
+	StatsByBlueprint.Reset();
+	PeepholeComparisons.Reset();
+	PendingBlueprints.Reset();
+}
@@ -0,0 +1,118 @@
+﻿#pragma once
+
+#include "EditorSubsystem.h"
+#include "UObject/SoftObjectPath.h"
+
+#include "BangoExpansionStatsSubsystem.generated.h"
+
+class UBlueprint;
+
+struct FBangoNodeExpansionStats
+{
+	int32 NumExpansions = 0;
+	
+	int32 NumIntermediateNodes = 0;
+	
+	int32 NumTemporaries = 0;
+	
+	double ExpandSeconds = 0.0;
+	
+	void Accumulate(const FBangoNodeExpansionStats& Other)
+	{
+		NumExpansions += Other.NumExpansions;
+		NumIntermediateNodes += Other.NumIntermediateNodes;
+		NumTemporaries += Other.NumTemporaries;
+		ExpandSeconds += Other.ExpandSeconds;
+	}
+};
+
+struct FBangoBlueprintExpansionStats
+{
+	TMap<FName, FBangoNodeExpansionStats> NodeTypes;
+	
+	// Filled in once the compile finishes
+	int32 BytecodeSize = 0;
+	
+	int32 PersistentFrameSize = 0;
+	
+	// Nodes removed by FBangoScriptCompilerContext's peephole pass, per pass
+	TMap<FName, int32> PeepholeRemovals;
+	
+	int32 GetNumPeepholeRemovals() const;
+};
+
+struct FBangoCompiledCodeSize
+{
+	int32 BytecodeSize = INDEX_NONE;
+	
+	int32 NumStatements = 0;
+	
+	bool IsSet() const { return BytecodeSize != INDEX_NONE; }
+};
+
+// The last full compile of a blueprint with the peephole pass off and with it on. Unlike the expansion stats these survive recompiles.
+struct FBangoPeepholeComparison
+{
+	FBangoCompiledCodeSize WithoutPass;
+	
+	FBangoCompiledCodeSize WithPass;
+	
+	bool IsComplete() const { return WithoutPass.IsSet() && WithPass.IsSet(); }
+};
+
+/**
+ * Collects what each Bango node expansion adds to a compile: intermediate nodes, temporaries and time spent, per blueprint and per node type. Bytecode and
+ * persistent ubergraph frame sizes are taken from the generated class afterwards, per blueprint (the compiler doesn't attribute bytecode to source nodes).
+ * Each compile replaces the previous numbers of that blueprint. Nodes removed by the optional Bango script peephole pass are counted here as well.
+ *
+ * Console commands:
+ *   Bango.ExpansionStats [Top]				- Logs the totals per node type and the blueprints with the most bytecode
+ *   Bango.ExpansionStats.Csv [FilePath]	- Writes one row per blueprint and node type, defaults to Saved/Profiling/BangoExpansionStats.csv
+ *   Bango.ExpansionStats.Peephole [Path]	- Compiles every Bango script (under Path) with the peephole pass off and on and logs the bytecode and statement delta
+ *   Bango.ExpansionStats.Reset
+ */
+UCLASS()
+class UBangoExpansionStatsSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	TMap<FSoftObjectPath, FBangoBlueprintExpansionStats> StatsByBlueprint;
+	
+	TMap<FSoftObjectPath, FBangoPeepholeComparison> PeepholeComparisons;
+	
+	// Blueprints that had Bango nodes expanded since the last OnBlueprintCompiled
+	TArray<TWeakObjectPtr<UBlueprint>> PendingBlueprints;
+	
+	FDelegateHandle PreCompileHandle;
+	
+	FDelegateHandle CompiledHandle;
+	
+public:
+	void Initialize(FSubsystemCollectionBase& Collection) override;
+	
+	void Deinitialize() override;
+	
+	static void RecordExpansion(UBlueprint* Blueprint, UClass* NodeClass, const FBangoNodeExpansionStats& Stats);
+	
+	static void RecordPeephole(UBlueprint* Blueprint, FName PassName, int32 NumRemovedNodes);
+	
+	static void RecordCompiledCode(UBlueprint* Blueprint, bool bPeepholePass, int32 BytecodeSize, int32 NumStatements);
+	
+	void LogStats(int32 NumBlueprintsToLog) const;
+	
+	// Compiles every Bango script blueprint under Path twice, with the peephole pass off and on, and logs the difference. The scripts are left compiled
+	// with the current Bango.Cook.OptimizeScripts setting.
+	void ComparePeephole(const FString& Path);
+	
+	void LogPeepholeComparison() const;
+	
+	bool WriteCsv(const FString& FilePath) const;
+	
+	void Reset();
+	
+protected:
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+	
+	void OnBlueprintCompiled();
+};
@@ -1,103 +1,45 @@
 ﻿#include "BangoNamedReroutesHelper.h"
 
 #include "Editor.h"
+#include "EdGraph/EdGraph.h"
 #include "BangoScripts/Uncooked/K2Nodes/K2Node_BangoGotoDestination.h"
 #include "BangoScripts/Uncooked/K2Nodes/K2Node_BangoGotoStart.h"
 
-TMap<FName, TArray<UEdGraphPin*>> UBangoNamedReroutesHelper::DestinationConnections;
-TMap<FName, UEdGraphPin*> UBangoNamedReroutesHelper::SourceConnections;
-TMap<UEdGraphPin*, UEdGraphPin*> UBangoNamedReroutesHelper::DestinationReroutes;
-
-void UBangoNamedReroutesHelper::Initialize(FSubsystemCollectionBase& Collection)
+const FBangoGotoIndex& UBangoNamedReroutesHelper::GetGotoIndex(UEdGraph* SourceGraph)
 {
-	if (!GEditor)
-	{
-		return;
-	}
+	check(GEditor);
+	check(SourceGraph);
 	
-	GEditor->OnBlueprintPreCompile().AddStatic(&ThisClass::OnBlueprintPreCompile);
-}
-
-UEdGraphPin* UBangoNamedReroutesHelper::GetSource(FName Name)
-{
-	UEdGraphPin** Source = SourceConnections.Find(Name);
+	UBangoNamedReroutesHelper* Helper = GEditor->GetEditorSubsystem<UBangoNamedReroutesHelper>();
+	check(Helper);
 	
-	if (Source)
+	if (const FBangoGotoIndex* ExistingIndex = Helper->IndicesByGraph.Find(SourceGraph))
 	{
-		return *Source;
+		return *ExistingIndex;
 	}
 	
-	return nullptr;
-}
-
-const TArray<UEdGraphPin*> UBangoNamedReroutesHelper::GetDestinations(FName Name)
-{
-	TArray<UEdGraphPin*>* Destinations = DestinationConnections.Find(Name);
-	
-	if (!Destinations)
+	// Drop indices of graphs from earlier compiles
+	for (auto It = Helper->IndicesByGraph.CreateIterator(); It; ++It)
 	{
-		return {};
-	}
-	
-	return *Destinations;
-}
-
-void UBangoNamedReroutesHelper::OnBlueprintPreCompile(UBlueprint* Blueprint)
-{
-	DestinationConnections.Empty();
-	DestinationReroutes.Empty();
-
-	for (const TObjectPtr<UEdGraph>& Ubergraph : Blueprint->UbergraphPages)
-	{
-		for (const TObjectPtr<class UEdGraphNode>& Node : Ubergraph->Nodes)
+		if (!It.Key().ResolveObjectPtr())
 		{
-			if (auto* GotoSource = Cast<UK2Node_BangoGotoStart>(Node))
-			{
-				//GotoSources.Add(GotoSource);
-			}
-			if (auto* GotoDestination = Cast<UK2Node_BangoGotoDestination>(Node))
-			{
-				RegisterDestination(GotoDestination);
-			}
+			It.RemoveCurrent();
 		}
 	}
-}
-
-void UBangoNamedReroutesHelper::RegisterDestination(UK2Node_BangoGotoDestination* Destination)
-{
-	//GotoDestinations.Add(Destination);
-	
-	if (Destination->GetRerouteName().IsNone() || !Destination->GetThenPin()->HasAnyConnections())
-	{
-		return;
-	}
 	
-	TArray<UEdGraphPin*>& Destinations = DestinationConnections.FindOrAdd(Destination->GetRerouteName());
-
-	Destinations.Add(Destination->GetExecPin());
-}
-
-void UBangoNamedReroutesHelper::UnregisterDestination(UK2Node_BangoGotoDestination* Destination)
-{
-	DestinationConnections.Remove(Destination->GetRerouteName());
-}
-
-/*
-void UBangoNamedReroutesHelper::RegisterDestinationReroute(UEdGraphPin* OldPinAddress, UEdGraphPin* NewPinAddress)
-{
-	DestinationReroutes.Add(OldPinAddress, NewPinAddress);
-}
-*/
-
-UEdGraphPin* UBangoNamedReroutesHelper::GetReroutedPin(UEdGraphPin* OriginalPinAddress)
-{
-	UEdGraphPin** Reroute = DestinationReroutes.Find(OriginalPinAddress);
+	FBangoGotoIndex& Index = Helper->IndicesByGraph.Add(SourceGraph);
 	
-	if (Reroute)
+	for (UEdGraphNode* Node : SourceGraph->Nodes)
 	{
-		return *Reroute;
+		if (UK2Node_BangoGotoStart* GotoStart = Cast<UK2Node_BangoGotoStart>(Node))
+		{
+			Index.EntriesByName.FindOrAdd(GotoStart->GetRerouteName()).Starts.Add(GotoStart);
+		}
+		else if (UK2Node_BangoGotoDestination* GotoDestination = Cast<UK2Node_BangoGotoDestination>(Node))
+		{
+			Index.EntriesByName.FindOrAdd(GotoDestination->GetRerouteName()).Destinations.Add(GotoDestination);
+		}
 	}
 	
-	return OriginalPinAddress;
+	return Index;
 }
-
@@ -1,39 +1,42 @@
 ﻿#pragma once
 
 #include "EditorSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "BangoNamedReroutesHelper.generated.h"
 
 class UK2Node_BangoGotoStart;
 class UK2Node_BangoGotoDestination;
-class UEdGraphPin;
+class UEdGraph;
 
+// Every goto node of one graph, grouped by reroute name (in graph node order)
+struct FBangoGotoIndex
+{
+	struct FEntry
+	{
+		TArray<UK2Node_BangoGotoStart*, TInlineAllocator<1>> Starts;
+		
+		TArray<UK2Node_BangoGotoDestination*, TInlineAllocator<2>> Destinations;
+	};
+	
+	TMap<FName, FEntry> EntriesByName;
+	
+	const FEntry* Find(FName Name) const { return EntriesByName.Find(Name); }
+};
+
+/**
+ * Hands out a goto index for each graph being expanded. The index is built by whichever goto node of that graph expands first and is shared by the rest,
+ * so resolving all gotos takes one pass over the graph. The graphs being expanded are intermediate copies made for a single compile; an index is dropped
+ * once its graph has been garbage collected.
+ */
 UCLASS()
 class UBangoNamedReroutesHelper : public UEditorSubsystem
 {
 	GENERATED_BODY()
 
 protected:
-	static TMap<FName, UEdGraphPin*> SourceConnections;
-	
-	static TMap<FName, TArray<UEdGraphPin*>> DestinationConnections;
-	
-	static TMap<UEdGraphPin*, UEdGraphPin*> DestinationReroutes;
+	TMap<TObjectKey<UEdGraph>, FBangoGotoIndex> IndicesByGraph;
 	
 public:
-	void Initialize(FSubsystemCollectionBase& Collection) override;
-
-	static UEdGraphPin* GetSource(FName Name);
-	
-	static const TArray<UEdGraphPin*> GetDestinations(FName Name);
-
-	static void OnBlueprintPreCompile(UBlueprint* Blueprint);
-	
-	static void RegisterDestination(UK2Node_BangoGotoDestination* Destination);
-	
-	static void UnregisterDestination(UK2Node_BangoGotoDestination* Destination);
-	
-	//static void RegisterDestinationReroute(UEdGraphPin* OldPinAddress, UEdGraphPin* NewPinAddress);
-	
-	static UEdGraphPin* GetReroutedPin(UEdGraphPin* OriginalPinAddress);
-};
\ No newline at end of file
+	static const FBangoGotoIndex& GetGotoIndex(UEdGraph* SourceGraph);
+};
@@ -7,7 +7,8 @@ class UBangoScriptBlueprint;
 
 #define LOCTEXT_NAMESPACE "BangoScripts"
 
-UCLASS(Abstract, MinimalAPI)
+// Bump BangoExpansionVersion whenever expansion changes in a way that alters the compiled output, see Bango::GraphHash
+UCLASS(Abstract, MinimalAPI, meta = (BangoExpansionVersion = "2"))
 class UK2Node_BangoBase : public UK2Node
 {
 	GENERATED_BODY()
@@ -6,7 +6,7 @@
 
 #include "K2Node_BangoGotoDestination.generated.h"
 
-UCLASS(MinimalAPI, DisplayName = "Goto (Destination)")
+UCLASS(MinimalAPI, DisplayName = "Goto (Destination)", meta = (BangoExpansionVersion = "2"))
 class UK2Node_BangoGotoDestination : public UK2Node_BangoBase
 {
 	GENERATED_BODY()
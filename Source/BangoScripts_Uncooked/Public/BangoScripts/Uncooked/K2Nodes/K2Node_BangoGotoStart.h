@@ -7,7 +7,7 @@
 #include "K2Node_BangoGotoStart.generated.h"
 
 
-UCLASS(MinimalAPI, DisplayName = "Goto (Source)")
+UCLASS(MinimalAPI, DisplayName = "Goto (Source)", meta = (BangoExpansionVersion = "2"))
 class UK2Node_BangoGotoStart : public UK2Node_BangoBase
 {
 	GENERATED_BODY()
@@ -47,11 +47,15 @@ public:
 
 	void ExpandNode(class FKismetCompilerContext& Compiler, UEdGraph* SourceGraph) override;
 	
+	// The script class's inputs become argument pins, so its blueprint is a dependency
+	bool HasExternalDependencies(TArray<class UStruct*>* OptionalOutput) const override;
+	
     UEdGraphPin* FindPropertyPin(const FName InPinName) const;
     
     UPROPERTY()
     TArray<FName> PinNames;
 
+	// Reconciles the argument pins with the script class's inputs. Skipped when the current argument pins already match the class's pin signature.
 	void UpdateScriptPins(UObject* InClassObject);
 };
 
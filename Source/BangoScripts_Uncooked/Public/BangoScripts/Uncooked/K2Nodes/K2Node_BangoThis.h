@@ -13,7 +13,7 @@
  * during creation of a Level Script, but you can also open the details panel to configure it. You could 
  * use this, for example, to destroy a trigger after the script runs.
  */
-UCLASS(MinimalAPI, DisplayName = "This")
+UCLASS(MinimalAPI, DisplayName = "This", meta = (BangoExpansionVersion = "3"))
 class UK2Node_BangoThis : public UK2Node_BangoBase, public FTickableEditorObject
 {
 public:
@@ -32,6 +32,13 @@ protected:
 public:
 	UClass* GetClassType() const { return ClassType; }
 	
+	// Class of the This pin, falls back to UObject when neither the node nor the script picked one
+	UClass* GetOutputClass() const;
+	
+	// Name of the typed This property the script compiler adds for this output class; This nodes compile to a plain read of it. Includes a hash of the
+	// class's path, so classes with the same name in different packages get different properties.
+	static FName GetTypedThisPropertyName(const UClass* OutputClass);
+	
 public:
 	void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 	
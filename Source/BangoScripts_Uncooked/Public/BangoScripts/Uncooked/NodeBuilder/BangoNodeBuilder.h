@@ -205,70 +205,62 @@ inline void BangoRunScript::Construct()
 }
 
 // ==========================================
-/*
-MAKE_NODE_TYPE(BangoExecuteScript_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Exec, Then, Target, Result);
+MAKE_NODE_TYPE(BangoRunScript_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Exec, Then, ScriptClass, InputNames, OnFinished, Handle);
 
-inline void BangoExecuteScript_Internal::Construct()
+inline void BangoRunScript_Internal::Construct()
 {
-	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, Execute_Internal)));
+	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, RunScript_Internal)));
 	AllocateDefaultPins();
 	Exec = _Node->GetExecPin();
 	Then = _Node->GetThenPin();
-	Target = FindPin("Self");
-	Result = _Node->GetReturnValuePin();
+	ScriptClass = FindPin("ScriptClass");
+	InputNames = FindPin("InputNames");
+	OnFinished = FindPin("OnFinished");
+	Handle = _Node->GetReturnValuePin();
 }
-*/
 
 // ==========================================
-MAKE_NODE_TYPE(BangoCancelSleep_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Exec, Then, ActionUUID);
+/*
+MAKE_NODE_TYPE(BangoExecuteScript_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Exec, Then, Target, Result);
 
-inline void BangoCancelSleep_Internal::Construct()
+inline void BangoExecuteScript_Internal::Construct()
 {
-	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, CancelSleep_Internal)));
+	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, Execute_Internal)));
 	AllocateDefaultPins();
 	Exec = _Node->GetExecPin();
 	Then = _Node->GetThenPin();
-	ActionUUID = FindPin("ActionUUID");
+	Target = FindPin("Self");
+	Result = _Node->GetReturnValuePin();
 }
+*/
 
 // ==========================================
-MAKE_NODE_TYPE(BangoLaunchSleep_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Exec, Then, ReturnValue, Duration, TickDelegate, CompleteDelegate);
+MAKE_NODE_TYPE(BangoSleep_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Start, Skip, Cancel, Then, Duration, TickDelegate);
 
-inline void BangoLaunchSleep_Internal::Construct()
+inline void BangoSleep_Internal::Construct()
 {
-	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, LaunchSleep_Internal)));
+	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, Sleep_Internal)));
 	AllocateDefaultPins();
-	Exec = _Node->GetExecPin();
+	Start = FindPin("Start");
+	Skip = FindPin("Skip");
+	Cancel = FindPin("Cancel");
 	Then = _Node->GetThenPin();
 	Duration = FindPin("Duration");
 	TickDelegate = FindPin("TickDelegate");
-	CompleteDelegate = FindPin("CompleteDelegate");
-	ReturnValue = _Node->GetReturnValuePin();
-}
-
-// ==========================================
-MAKE_NODE_TYPE(BangoSkipSleep_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Exec, Then, ActionUUID);
-
-inline void BangoSkipSleep_Internal::Construct()
-{
-	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, SkipSleep_Internal)));
-	AllocateDefaultPins();
-	Exec = _Node->GetExecPin();
-	ActionUUID = FindPin("ActionUUID");
-	Then = _Node->GetThenPin();
 }
 
 // ==========================================
-MAKE_NODE_TYPE(BangoPauseSleep_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Exec, Then, Paused, ActionUUID);
+MAKE_NODE_TYPE(BangoSetSleepConditions_Internal, UK2Node_CallFunction, NORMAL_CONSTRUCTION, Exec, Then, Skip, Cancel, Paused);
 
-inline void BangoPauseSleep_Internal::Construct()
+inline void BangoSetSleepConditions_Internal::Construct()
 {
-	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, SetSleepPause_Internal)));
+	_Node->SetFromFunction(UBangoScript::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBangoScript, SetSleepConditions_Internal)));
 	AllocateDefaultPins();
 	Exec = _Node->GetExecPin();
 	Then = _Node->GetThenPin();
+	Skip = FindPin("bSkip");
+	Cancel = FindPin("bCancel");
 	Paused = FindPin("bPaused");
-	ActionUUID = FindPin("ActionUUID");
 }
 
 // ==========================================
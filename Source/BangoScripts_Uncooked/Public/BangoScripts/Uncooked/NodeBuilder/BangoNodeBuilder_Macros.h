@@ -19,7 +19,7 @@
 
 #define STRIP_AST()
 
-#define DECL_PIN(Name) UEdGraphPin* Name;
+#define DECL_PIN(Name) UEdGraphPin* Name = nullptr;
 #define ARR_PIN(Name) Name,
 
 // We have support for up to 12 compile-time named pins...
@@ -44,12 +44,17 @@ namespace BangoNodeBuilder\
 {\
 	struct NodeType : public NodeWrapper<Name>\
 	{\
-		using NodeWrapper::NodeWrapper;\
+		/* Construction has to happen here rather than in NodeWrapper, Construct() is only reachable once the derived type exists */\
+		NodeType(float X, float Y, Builder& InBuilder) : NodeWrapper(X, Y, InBuilder) { InBuilder.RegisterNode(*this); }\
+		\
+		NodeType(Name* InNode, Builder& InBuilder) : NodeWrapper(InNode) { InBuilder.RegisterNode(*this); }\
 		\
 		virtual ~NodeType() {};\
 		\
 		CONCAT(IF_DEFERRED_, USE_DEFERRED)(bool UseDeferredConstruction() override { return true; })\
 		\
+		TArrayView<FBangoPinLookup> GetPinLookupCache() override { static FBangoPinLookup Cache[12]; return Cache; }\
+		\
 		/*Declare pins*/\
 		FOR_EACH(DECL_PIN, __VA_ARGS__)\
 		\
@@ -65,10 +70,35 @@ enum class EBangoPinRequired : uint8
 	Optional,
 };
 
+// One FindPin call site of a node type. Construct() looks its pins up in the same order every time, so the n-th lookup of a node type keeps the FName
+// (building one from a string goes through the name table) and where the pin was found last time.
+struct FBangoPinLookup
+{
+	const char* Literal = nullptr;
+	
+	FName Name;
+	
+	int32 Index = INDEX_NONE;
+};
+
 struct NodeWrapper_Base
 {
 	bool bFinishedSpawning = false;
 	
+	int32 NumPinLookups = 0;
+	
+	// Required pins that FindPin couldn't find. Reported by Builder::FinishDeferredNodes.
+	TArray<FName, TInlineAllocator<2>> MissingPins;
+	
+	NodeWrapper_Base() = default;
+	
+	// The builder keeps a pointer to every wrapper, so wrappers must stay where MakeNode/WrapExistingNode constructed them
+	NodeWrapper_Base(const NodeWrapper_Base&) = delete;
+	
+	NodeWrapper_Base& operator=(const NodeWrapper_Base&) = delete;
+	
+	virtual ~NodeWrapper_Base() {};
+	
 	virtual bool UseDeferredConstruction()
 	{
 		return false;
@@ -81,6 +111,7 @@ struct NodeWrapper_Base
 			return;
 		}
 
+		NumPinLookups = 0;
 		Construct();
 		bFinishedSpawning = true;
 	}
@@ -92,6 +123,7 @@ struct NodeWrapper_Base
 			return;
 		}
 		
+		NumPinLookups = 0;
 		Construct();
 		bFinishedSpawning = true;
 	}
@@ -99,6 +131,8 @@ struct NodeWrapper_Base
 	virtual void Construct() {};
 
 	virtual UEdGraphNode* BaseNode() { return nullptr; }
+	
+	virtual TArrayView<FBangoPinLookup> GetPinLookupCache() { return {}; }
 };
 
 namespace BangoNodeBuilder
@@ -115,11 +149,18 @@ namespace BangoNodeBuilder
 		const UEdGraphSchema* _Schema;
 		bool* _bErrorBool;
 
-		TArray<NodeWrapper_Base*> SpawnedNodes;
+		TArray<NodeWrapper_Base*, TInlineAllocator<8>> SpawnedNodes;
 		bool bAwaitingSpawnFinish = false;
 		
+		// Expansion statistics, everything added to the graph while this builder is alive is attributed to the source node
+		int32 _NumGraphNodesAtStart = 0;
+		double _StartTime = 0.0;
+		
 		Builder(class FKismetCompilerContext& InContext, UEdGraph* InParentGraph, class UK2Node* InSourceNode, const UEdGraphSchema* InSchema, bool* InErrorBool, FVector2f Anchor = FVector2f::ZeroVector);
+		
+		~Builder();
 
+		// Constructs deferred nodes, then validates every spawned node in one pass (missing required pins are reported as compiler errors)
 		void FinishDeferredNodes(bool bLogUnconnectedPins = false);
 
 		void MoveExternalConnection(UEdGraphPin* From, UEdGraphPin* To);
@@ -128,30 +169,27 @@ namespace BangoNodeBuilder
 
 		void CreateConnection(UEdGraphPin* From, UEdGraphPin* To);
 
-		void SetDefaultValue(UEdGraphPin* Pin, FString& Value);
+		void SetDefaultValue(UEdGraphPin* Pin, const FString& Value);
 
 		void SetDefaultObject(UEdGraphPin* Pin, UObject* Value);
 
+		// Both of these return a prvalue, so the wrapper is constructed directly in the caller's variable and the address registered below stays valid
 		template<typename TT>
 		TT MakeNode(float X, float Y)
 		{
-			TT NewNodeWrapper = TT(X, Y, *this);
-			NewNodeWrapper.NormalConstruction();
-		
-			SpawnedNodes.Add(&NewNodeWrapper);
-		
-			return NewNodeWrapper;
+			return TT(X, Y, *this);
 		}
 	
 		template<typename TT, typename T>
 		TT WrapExistingNode(T* InNode)
 		{
-			TT NewNodeWrapper(InNode);
-			NewNodeWrapper.NormalConstruction();
-
-			SpawnedNodes.Add(&NewNodeWrapper);
+			return TT(InNode, *this);
+		}
 		
-			return NewNodeWrapper;
+		void RegisterNode(NodeWrapper_Base& NodeWrapper)
+		{
+			NodeWrapper.NormalConstruction();
+			SpawnedNodes.Add(&NodeWrapper);
 		}
 	};
 		
@@ -194,16 +232,52 @@ namespace BangoNodeBuilder
 		
 		UEdGraphPin* FindPin(const char* PinName, EBangoPinRequired PinRequired = EBangoPinRequired::Required)
 		{
-			return FindPin(FName(PinName), PinRequired);
+			TArrayView<FBangoPinLookup> Cache = GetPinLookupCache();
+			const int32 LookupIndex = NumPinLookups++;
+			
+			if (!Cache.IsValidIndex(LookupIndex))
+			{
+				return FindPin(FName(PinName), PinRequired);
+			}
+			
+			FBangoPinLookup& Lookup = Cache[LookupIndex];
+			
+			if (Lookup.Literal != PinName)
+			{
+				Lookup.Literal = PinName;
+				Lookup.Name = FName(PinName);
+				Lookup.Index = INDEX_NONE;
+			}
+			
+			const TArray<UEdGraphPin*>& Pins = _Node->Pins;
+			
+			if (Pins.IsValidIndex(Lookup.Index) && Pins[Lookup.Index]->PinName == Lookup.Name)
+			{
+				return Pins[Lookup.Index];
+			}
+			
+			Lookup.Index = Pins.IndexOfByPredicate([&Lookup] (const UEdGraphPin* Pin) { return Pin->PinName == Lookup.Name; });
+			
+			if (Lookup.Index == INDEX_NONE)
+			{
+				if (PinRequired == EBangoPinRequired::Required)
+				{
+					MissingPins.Add(Lookup.Name);
+				}
+				
+				return nullptr;
+			}
+			
+			return Pins[Lookup.Index];
 		}
 		
 		UEdGraphPin* FindPin(FName PinName, EBangoPinRequired PinRequired = EBangoPinRequired::Required)
 		{
 			UEdGraphPin* Pin = _Node->FindPin(PinName);
 			
-			if (PinRequired == EBangoPinRequired::Required)
+			if (!Pin && PinRequired == EBangoPinRequired::Required)
 			{
-				check(Pin);
+				MissingPins.Add(PinName);
 			}
 				
 			return Pin;